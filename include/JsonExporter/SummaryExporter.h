@@ -2,6 +2,7 @@
 #define SUMMARYEXPORTER_H
 
 #include "taintanalysis/SummaryItem.h"
+#include "taintanalysis/FunctionSummary.h"
 #include <nlohmann/json.hpp>
 #include <vector>
 #include <string>
@@ -11,6 +12,9 @@ public:
     // 将SummaryItem向量转换为JSON字符串
     static nlohmann::json toJson(const std::vector<SummaryItem>& summaryItems);
 
+    // 将单个函数的摘要转换为 {name, params, instructions} 形式的JSON
+    static nlohmann::json toJson(const FunctionSummary& summary);
+
     static void exportToFile(const std::vector<SummaryItem>& summaryItems, const std::string& filename);
 };
 
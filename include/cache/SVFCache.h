@@ -0,0 +1,34 @@
+#ifndef SVF_CACHE_H
+#define SVF_CACHE_H
+
+#include <string>
+
+// SVF 构造结果的磁盘缓存：以"bitcode 内容哈希 + 生效的 SVF 选项"为键，
+// 目前缓存 Andersen 指针分析结果（借助 SVF 自带的 -write-ander / -read-ander），
+// 命中时跳过约束求解
+class SVFCache {
+public:
+    // 环境变量 NAPI_SVF_CACHE 为 0/false/off 时关闭缓存
+    static bool isEnabled();
+
+    // 缓存目录：环境变量 NAPI_SVF_CACHE_DIR，默认为 result/.svf_cache
+    static std::string cacheDir();
+
+    // 计算缓存键，读取 bitcode 失败时返回空串
+    static std::string computeKey(const std::string& bitcodePath);
+
+    // 在构建 Andersen 之前调用：设置 -read-ander 为缓存文件；未命中时 -write-ander 为临时文件，
+    // 命中时置空。返回缓存文件是否已存在
+    static bool prepareAndersen(const std::string& key);
+
+    // Andersen 求解完成后调用：若本次重新求解，把临时文件原子地移动为正式缓存文件
+    static void commitAndersen(const std::string& key);
+
+private:
+    static std::string anderPath(const std::string& key);
+    static std::string pendingAnderPath(const std::string& key);
+    // 通过 SVF 的命令行解析器设置读/写 Andersen 结果的路径
+    static void setAnderOptions(const std::string& readPath, const std::string& writePath);
+};
+
+#endif // SVF_CACHE_H
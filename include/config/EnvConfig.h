@@ -0,0 +1,45 @@
+#ifndef ENV_CONFIG_H
+#define ENV_CONFIG_H
+
+#include <cstdlib>
+#include <string>
+
+// 运行参数统一通过环境变量配置（与 HARMONY_OS_PATH / wllvm_path 的用法保持一致）
+namespace EnvConfig {
+
+// 读取整数型环境变量，未设置或无法解析时返回默认值
+inline long getLong(const char* name, long defaultValue) {
+    const char* value = std::getenv(name);
+    if (value == nullptr || *value == '\0') {
+        return defaultValue;
+    }
+    char* end = nullptr;
+    long parsed = std::strtol(value, &end, 10);
+    if (end == value) {
+        return defaultValue;
+    }
+    return parsed;
+}
+
+// 读取字符串型环境变量
+inline std::string getString(const char* name, const std::string& defaultValue) {
+    const char* value = std::getenv(name);
+    if (value == nullptr || *value == '\0') {
+        return defaultValue;
+    }
+    return std::string(value);
+}
+
+// 读取开关型环境变量："0"/"false"/"off" 视为关闭，其余非空值视为开启
+inline bool getBool(const char* name, bool defaultValue) {
+    const char* value = std::getenv(name);
+    if (value == nullptr || *value == '\0') {
+        return defaultValue;
+    }
+    std::string s(value);
+    return !(s == "0" || s == "false" || s == "off" || s == "OFF" || s == "False");
+}
+
+} // namespace EnvConfig
+
+#endif // ENV_CONFIG_H
@@ -0,0 +1,81 @@
+#ifndef ANALYSIS_CONTEXT_H
+#define ANALYSIS_CONTEXT_H
+
+#include "SVFIR/SVFIR.h"
+#include "WPA/Andersen.h"
+#include "Graphs/VFG.h"
+#include "Graphs/SVFG.h"
+#include "MSSA/SVFGBuilder.h"
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <string>
+
+// 指针分析的精度档位，由高到低
+enum class AnalysisTier {
+    Full,          // AndersenWaveDiff + 完整 SVFG
+    PtrOnly,       // AndersenWaveDiff + 仅指针的 SVFG
+    Unification    // Steensgaard（基于合一）+ 仅指针的 SVFG
+};
+
+// 单个库的分析上下文：加载 bitcode（默认先切片到 NAPI 入口可达的函数，可选规范化），依次构建 PAG、指针分析（按库的规模选择精度档位）、调用图与 SVFG，
+// 以及依附于模块和 SVFG 的各类索引；独立的 VFG 只在首次被查询时构建。
+// 属性解析与污点分析的各阶段都从这里取用这些对象，指针分析在每个库中只求解一次；
+// 所有对象在析构时按依赖的逆序统一释放。
+// 一个进程中同一时刻只能存在一个上下文（SVF 的 PAG 与 Andersen 均为全局单例）
+class AnalysisContext {
+public:
+    // bitcodePath 为库的最终 LLVM IR；启用 SVFCache 时复用缓存的 Andersen 结果（合一档位不使用缓存）
+    explicit AnalysisContext(const std::string& bitcodePath);
+    ~AnalysisContext();
+
+    AnalysisContext(const AnalysisContext&) = delete;
+    AnalysisContext& operator=(const AnalysisContext&) = delete;
+
+    SVF::SVFIR* getPAG() const { return pag; }
+    SVF::AndersenBase* getPointerAnalysis() const { return ander; }
+    SVF::CallGraph* getCallGraph() const { return callGraph; }
+    SVF::SVFG* getSVFG() const { return svfg; }
+    // 首次调用时构建 VFG，可被多个线程同时调用。
+    // 环境变量 NAPI_SVF_EAGER_VFG 开启时在构造上下文时即构建（与按需构建对比开销用）
+    SVF::VFG* getVFG();
+
+    // 本次 Andersen 结果是否读自缓存
+    bool andersenCacheHit() const { return anderCacheHit; }
+
+    AnalysisTier analysisTier() const { return tier; }
+    static const char* tierName(AnalysisTier tier);
+
+    // 精度档位的选择：环境变量 NAPI_SVF_ANALYSIS_TIER 为 full/ptr_only/unification 时固定档位，默认 auto，
+    // 此时 bitcode 超过 NAPI_SVF_TIER_PTR_ONLY_MB（默认 64）或 PAG 节点数超过 NAPI_SVF_TIER_PTR_ONLY_PAG_NODES
+    // （默认 200 万）时降为 ptr_only，超过 NAPI_SVF_TIER_UNIFICATION_MB（默认 256）或
+    // NAPI_SVF_TIER_UNIFICATION_PAG_NODES（默认 800 万）时降为 unification
+    static AnalysisTier selectTier(uintmax_t bitcodeBytes, size_t pagNodes);
+
+    // VFG 的构建方式、是否构建及其耗时与常驻内存增量，写入库的指标记录。
+    // 须在所有可能查询 VFG 的分析结束后调用
+    nlohmann::json vfgStats() const;
+
+    // SVF 构造前的预处理记录：module_slice 为切片前后的函数与指令数，
+    // canonicalize 为规范化前后的 IR 规模（开启 NAPI_SVF_CANONICALIZE_MEASURE 时另有 PAG 节点、边数）；未启用的步骤不出现
+    const nlohmann::json& preprocessStats() const { return preprocessing; }
+
+private:
+    SVF::SVFIR* pag = nullptr;
+    SVF::AndersenBase* ander = nullptr;
+    AnalysisTier tier = AnalysisTier::Full;
+    SVF::CallGraph* callGraph = nullptr;
+    SVF::VFG* vfg = nullptr;
+    std::once_flag vfgOnce;
+    bool eagerVFG = false;
+    double vfgBuildSeconds = 0.0;
+    long vfgRssDeltaKb = 0;
+    std::unique_ptr<SVF::SVFGBuilder> svfgBuilder;   // 持有 SVFG
+    SVF::SVFG* svfg = nullptr;
+    bool anderCacheHit = false;
+    nlohmann::json preprocessing = nlohmann::json::object();
+    bool scratchInput = false;   // SVF 加载的是预处理后的中间文件而非输入本身
+};
+
+#endif // ANALYSIS_CONTEXT_H
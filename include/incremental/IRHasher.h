@@ -0,0 +1,24 @@
+#ifndef IR_HASHER_H
+#define IR_HASHER_H
+
+#include <llvm/IR/Function.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// 函数IR的结构化哈希：只依赖指令的操作码、类型、常量与被引用的全局符号名，
+// 局部值按出现顺序编号，因此与值名称、调试信息无关，跨进程、跨运行稳定
+class IRHasher {
+public:
+    // 单个函数体的哈希（声明只哈希名称与类型）
+    uint64_t hashFunction(const llvm::Function* func);
+
+    // 函数及其全部直接/间接被调函数（与 TaintTracker::getCalledFunctions 的遍历范围一致）的组合哈希，
+    // 以十六进制字符串返回
+    std::string hashClosure(const llvm::Function* func);
+
+private:
+    std::unordered_map<const llvm::Function*, uint64_t> functionHashes;
+};
+
+#endif // IR_HASHER_H
@@ -0,0 +1,35 @@
+#ifndef SUMMARY_MANIFEST_H
+#define SUMMARY_MANIFEST_H
+
+#include <nlohmann/json.hpp>
+#include <string>
+
+// 单个库的增量分析清单（result/<project>/<so>.manifest.json）：
+// 记录每个导出函数调用闭包的IR哈希及其摘要，闭包未变化的函数直接复用上次的摘要
+class SummaryManifest {
+public:
+    explicit SummaryManifest(const std::string& path);
+
+    // 读取上次的清单，文件不存在、格式错误、版本不符或由另一个构建的分析程序写出时返回 false
+    //（视为全部需要重新分析）
+    bool load();
+
+    // 哈希一致时返回上次保存的摘要，否则返回 nullptr
+    const nlohmann::json* lookup(const std::string& funcName, const std::string& hash) const;
+
+    // 记录本次的哈希与摘要
+    void record(const std::string& funcName, const std::string& hash, const nlohmann::json& summary);
+
+    // 写出本次记录的清单，只包含本次出现的函数
+    bool save() const;
+
+    // 环境变量 NAPI_SVF_INCREMENTAL 为 0/false/off 时关闭增量分析
+    static bool isEnabled();
+
+private:
+    std::string path;
+    nlohmann::json previous;
+    nlohmann::json current;
+};
+
+#endif // SUMMARY_MANIFEST_H
@@ -0,0 +1,74 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 分析过程中的计数器，按线程各自累计，热点路径上不需要原子操作
+struct MetricCounters {
+    uint64_t handlerInvocations = 0;   // NAPI 处理函数的调用次数
+    uint64_t svfgNodesVisited = 0;     // 遍历或扫描过的 SVFG 节点数
+    uint64_t aliasQueries = 0;         // 发出的别名查询次数
+    uint64_t slicesComputed = 0;       // 实际计算的反向切片数
+    uint64_t sliceCacheHits = 0;       // 命中切片缓存的次数
+    uint64_t slicesTruncated = 0;      // 因结果数或访问节点数上限而提前截断的切片数
+
+    MetricCounters& operator+=(const MetricCounters& other);
+    MetricCounters operator-(const MetricCounters& other) const;
+};
+
+// 指标收集与汇总：
+// 子进程（库分析、fork 模式下的函数分析）把各自的测量结果编码为JSON，通过结果管道回传，
+// 顶层父进程合并所有库的记录并计算分位数，写入 overall_timing_summary.json
+class Metrics {
+public:
+    // 当前线程的计数器
+    static MetricCounters& local();
+
+    static void countHandlerInvocation() { local().handlerInvocations++; }
+    static void countSvfgNodeVisit() { local().svfgNodesVisited++; }
+    static void countAliasQuery() { local().aliasQueries++; }
+    static void countSliceComputed() { local().slicesComputed++; }
+    static void countSliceCacheHit() { local().sliceCacheHits++; }
+    static void countSliceTruncated() { local().slicesTruncated++; }
+
+    // 当前线程的CPU时间（秒）
+    static double threadCpuSeconds();
+    // 当前进程及其已回收子进程的CPU时间（秒）
+    static double processCpuSeconds();
+    // 当前进程的峰值常驻内存（KB）
+    static long peakRssKb();
+    // 当前进程此刻的常驻内存（KB），读取 /proc/self/statm，失败时返回 0
+    static long currentRssKb();
+
+    static nlohmann::json countersToJson(const MetricCounters& counters);
+    static MetricCounters countersFromJson(const nlohmann::json& json);
+
+    // 一组数值的分布：count、total、p50、p90、p99、max（最近秩法）
+    static nlohmann::json distribution(std::vector<double> values);
+
+    // 合并所有库的指标记录（每条记录由 MetricsProbe::finish 生成并补充阶段耗时与函数记录）
+    static nlohmann::json summarize(const std::vector<nlohmann::json>& libraryRecords);
+};
+
+// 一次测量：构造时记录起点，finish 时生成包含墙钟时间、CPU时间、峰值RSS与计数器增量的记录。
+// 必须在同一线程中构造与 finish
+class MetricsProbe {
+public:
+    // processWide 为 true 时CPU时间按整个进程（含已回收子进程）统计，用于库级测量
+    explicit MetricsProbe(bool processWide = false);
+
+    MetricCounters counters() const { return Metrics::local() - startCounters; }
+    nlohmann::json finish(const std::string& name) const;
+
+private:
+    bool processWide;
+    std::chrono::steady_clock::time_point startTime;
+    double startCpu;
+    MetricCounters startCounters;
+};
+
+#endif // METRICS_H
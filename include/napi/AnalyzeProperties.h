@@ -9,7 +9,8 @@
 #include "Util/Options.h"
 class NapiPropertiesAnalyzer {
 public:
-    static std::set<llvm::GlobalVariable*> analyzeNapiProperties(SVF::SVFG* svfg,SVF::SVFIR* pag);
+    // 指针分析由调用方的分析上下文提供，属性解析不再自行创建
+    static std::set<llvm::GlobalVariable*> analyzeNapiProperties(SVF::SVFG* svfg, SVF::SVFIR* pag, SVF::PointerAnalysis* pta);
     static std::map<std::string, llvm::Function*> analyzeGlobalVars(std::set<llvm::GlobalVariable*> globalVars);
     // 处理通过napi_set_named_property注册的函数
     static std::map<std::string, llvm::Function*> analyzeNamedProperties(SVF::SVFG* svfg, SVF::SVFIR* pag, SVF::PointerAnalysis* pta);
@@ -19,12 +20,11 @@ public:
     static const SVF::SVFGNode* getDefSVFGNodeFromNodeID(SVF::NodeID nodeID, SVF::SVFG* svfg);
 
 private:
-    // 查找模块注册函数
-    static std::map<llvm::GlobalVariable*, const llvm::Function*> findModuleInitFunctions(llvm::Module* llvmModule);
+    // 查找模块注册函数（调用点取自 NapiCallSiteIndex）
+    static std::map<llvm::GlobalVariable*, const llvm::Function*> findModuleInitFunctions();
     
     // 分析napi_set_named_property调用与初始化函数返回值的关系
     static void analyzeSetNamedPropertyCalls(
-        llvm::Module* llvmModule, 
         const llvm::Function* initFunc, 
         SVF::NodeID retNodeId,
         SVF::SVFIR* pag, 
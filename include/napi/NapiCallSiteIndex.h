@@ -0,0 +1,42 @@
+#ifndef NAPI_CALL_SITE_INDEX_H
+#define NAPI_CALL_SITE_INDEX_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/InstrTypes.h>
+
+// 库加载后对全部模块做一次遍历建立的调用点索引：
+//   外部函数（NAPI 接口、libc 等入口）-> 调用它的调用点
+//   函数 -> 其中可解析出被调函数的调用点
+// 属性解析与污点分析都从这里查询调用点，不再各自重新扫描模块。
+// 建立后只读，可被多个分析线程共享；释放 LLVM 模块前须调用 clear
+class NapiCallSiteIndex {
+public:
+    static NapiCallSiteIndex& getInstance();
+
+    void build();
+    void clear();
+
+    // 对外部函数 calleeName 的全部调用点，按模块中的程序顺序排列
+    const std::vector<const llvm::CallBase*>& callSitesOf(const std::string& calleeName) const;
+    // 同上，只保留位于 caller 中的调用点
+    std::vector<const llvm::CallBase*> callSitesOf(const std::string& calleeName, const llvm::Function* caller) const;
+    // caller 中可解析出被调函数的调用点（含内部函数与外部函数），按程序顺序排列
+    const std::vector<const llvm::CallBase*>& callSitesIn(const llvm::Function* caller) const;
+
+    // 直接调用或经指针转换后调用的函数
+    static const llvm::Function* resolveCallee(const llvm::CallBase* callSite);
+
+private:
+    std::unordered_map<std::string, std::vector<const llvm::CallBase*>> callSitesByCallee;
+    llvm::DenseMap<const llvm::Function*, std::vector<const llvm::CallBase*>> callSitesByCaller;
+
+    NapiCallSiteIndex() = default;
+    NapiCallSiteIndex(const NapiCallSiteIndex&) = delete;
+    NapiCallSiteIndex& operator=(const NapiCallSiteIndex&) = delete;
+};
+
+#endif // NAPI_CALL_SITE_INDEX_H
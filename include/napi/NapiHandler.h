@@ -4,6 +4,7 @@
 #include <string>
 #include <unordered_map>
 #include <functional>
+#include <llvm/ADT/DenseMap.h>
 #include "SVFIR/SVFIR.h"
 #include "SVF-LLVM/LLVMUtil.h"
 #include "WPA/Andersen.h"
@@ -17,15 +18,26 @@ using namespace SVF;
 
 class NapiHandler {
 public:
-    using HandlerFunc = std::function<void(const llvm::Instruction*, TaintMap&, const SVFG*, const SVFIR*, SVF::Andersen*, std::vector<SummaryItem>&)>;
+    using HandlerFunc = std::function<void(const llvm::Instruction*, TaintMap&, const SVFG*, const SVFIR*, SVF::AndersenBase*, std::vector<SummaryItem>&)>;
 
     static NapiHandler& getInstance();
 
-    void dispatch(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::Andersen* ander, std::vector<SummaryItem>& summaryItems);
+    // 处理函数均在静态初始化阶段注册，dispatch 只读 handlerMap 与 boundHandlers，
+    // 每次分析的可变状态都经由 taintMap 与 summaryItems 传入，因此可被多个线程同时调用
+    void dispatch(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::AndersenBase* ander, std::vector<SummaryItem>& summaryItems);
     void registerHandler(const std::string& name, HandlerFunc func);
 
+    // 库加载后调用：把已加载模块中的每个函数一次性解析到其处理函数，
+    // 之后 dispatch 按被调函数指针查表，不再逐个调用构造函数名字符串
+    void bindModules();
+    // 释放 LLVM 模块前调用，回到按函数名查找
+    void clearBindings();
+
 private:
     std::unordered_map<std::string, HandlerFunc> handlerMap;
+    // 被调函数 -> 处理函数，只包含有处理函数的 NAPI 函数；bound 为 true 时不在表中的函数直接跳过
+    llvm::DenseMap<const llvm::Function*, const HandlerFunc*> boundHandlers;
+    bool bound = false;
 
     NapiHandler() = default; 
     NapiHandler(const NapiHandler&) = delete;
@@ -0,0 +1,28 @@
+#ifndef SLICECACHE_H
+#define SLICECACHE_H
+
+#include "Graphs/SVFG.h"
+#include <string>
+#include <vector>
+
+// bfsPredecessors 的反向切片缓存：同一函数的分析中多个处理函数会反复查询同一变量（env、cbinfo、argv 等），
+// 以 (SVFG, 起点变量) 为键缓存切片结果。缓存按线程各自保存，每个函数开始分析时清空。
+// 切片的规模上限由环境变量配置（0 表示不限制）：
+//   NAPI_SVF_SLICE_MAX_RESULTS  收集的前驱节点数上限（默认 20）
+//   NAPI_SVF_SLICE_MAX_VISITS   遍历的 SVFG 节点数上限（默认 0，不限制）
+class SliceCache {
+public:
+    static size_t maxResults();
+    static size_t maxVisits();
+    // 非默认上限会改变分析结果，返回记入增量哈希的标记；默认上限时为空串
+    static std::string budgetTag();
+
+    // 命中时把缓存的切片写入 slice 并返回 true
+    static bool lookup(const SVF::SVFG* svfg, SVF::NodeID startVar, std::vector<SVF::NodeID>& slice);
+    static void store(const SVF::SVFG* svfg, SVF::NodeID startVar, const std::vector<SVF::NodeID>& slice);
+
+    // 清空当前线程的缓存，在每个函数分析开始时调用
+    static void reset();
+};
+
+#endif // SLICECACHE_H
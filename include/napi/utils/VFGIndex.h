@@ -0,0 +1,53 @@
+#ifndef VFGINDEX_H
+#define VFGINDEX_H
+
+#include "Graphs/SVFG.h"
+#include "MemoryModel/PointerAnalysis.h"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// SVFG 的反向索引：PAG 变量 -> 以其为源或目标的语句节点；抽象对象 -> 取其地址的变量；
+// 存入整型常量的 Store 节点按目标指针（及其指向的对象）分桶。
+// 每个库在 buildFullSVFG 之后建立一次，之后只读，可被多个分析线程共享，fork 出的子进程也可直接使用；
+// 未建立索引的 SVFG 由调用方退回全图扫描
+class VFGIndex {
+public:
+    // 为 svfg 建立索引（已建立时不重复建立），pta 用于按指向集为 Store 节点分桶
+    static void build(const SVF::SVFG* svfg, SVF::PointerAnalysis* pta);
+    // SVFG 释放前调用，避免之后分配到相同地址的图误用旧索引
+    static void release(const SVF::SVFG* svfg);
+    // svfg 的索引，未建立时返回 nullptr
+    static const VFGIndex* get(const SVF::SVFG* svfg);
+
+    // 源或目标为 pagId 的语句节点，按 SVFG 节点编号升序排列
+    const std::vector<const SVF::StmtVFGNode*>& stmtNodesOf(SVF::NodeID pagId) const;
+
+    // 指针 ptrNodeId 所指对象中存入的整型常量（如 argc、长度），无法确定时返回 -1。
+    // 与逐个扫描 Addr/Store 节点的结果一致：依次取指向的对象，找到取其地址的变量后，
+    // 返回编号最小、目标指针与该变量可能别名的常量 Store。结果按 NodeID 缓存，各处理函数共享
+    int resolveIntValue(SVF::NodeID ptrNodeId) const;
+
+private:
+    SVF::PointerAnalysis* pta = nullptr;
+    std::unordered_map<SVF::NodeID, std::vector<const SVF::StmtVFGNode*>> stmtNodesByVar;
+
+    std::unordered_map<SVF::NodeID, SVF::NodeID> addrVarByObj;        // 对象 -> 第一个取其地址的变量
+    // 存入整型常量的 Store 节点，各桶内按 SVFG 节点编号升序
+    std::vector<const SVF::StoreVFGNode*> constStores;
+    std::unordered_map<SVF::NodeID, std::vector<const SVF::StoreVFGNode*>> constStoresByDst;
+    std::unordered_map<SVF::NodeID, std::vector<const SVF::StoreVFGNode*>> constStoresByObj;
+    std::vector<const SVF::StoreVFGNode*> blackHoleConstStores;      // 目标指针的指向集含黑洞节点
+
+    mutable std::mutex intValueMutex;
+    mutable std::unordered_map<SVF::NodeID, int> intValueCache;
+
+    // 目标指针与 addrVarId 可能别名的常量 Store 中编号最小的一个
+    const SVF::StoreVFGNode* firstConstStoreInto(SVF::NodeID addrVarId) const;
+
+    static std::mutex registryMutex;
+    static std::unordered_map<const SVF::SVFG*, std::unique_ptr<VFGIndex>> registry;
+};
+
+#endif // VFGINDEX_H
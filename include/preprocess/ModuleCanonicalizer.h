@@ -0,0 +1,28 @@
+#ifndef MODULE_CANONICALIZER_H
+#define MODULE_CANONICALIZER_H
+
+#include <nlohmann/json.hpp>
+#include <llvm/IR/Module.h>
+#include <string>
+
+// SVF 构造前的规范化：wllvm 提取的 -O0 bitcode 中大量的 alloca 与冗余 load/store 会使 PAG 和 SVFG 的内存 SSA 膨胀。
+// 依次执行：内联只有一个基本块的小包装函数、SROA、mem2reg、instsimplify、DCE。
+// 内容含 napi_* 调用的函数不会被内联，NAPI 调用点保留在原函数中；处理后 napi_* 调用点数目发生变化时放弃规范化
+class ModuleCanonicalizer {
+public:
+    // 环境变量 NAPI_SVF_CANONICALIZE 开启（默认关闭）；NAPI_SVF_CANONICALIZE_INLINE_LIMIT 为可内联包装函数的最大指令数（默认 8）
+    static bool isEnabled();
+
+    // 环境变量 NAPI_SVF_CANONICALIZE_MEASURE 开启（默认关闭）时，额外构建一次规范化前的 PAG，
+    // 在统计中记录规范化前后的 PAG 规模；这会使 PAG 构建的开销加倍，只在评估规范化效果时使用
+    static bool measurePAGEnabled();
+
+    // 读取 inputPath，规范化后以 bitcode 写入 outputPath；成功时返回 true，
+    // stats 记录处理前后的指令、alloca、load、store 数与内联的调用点数
+    static bool canonicalizeToFile(const std::string& inputPath, const std::string& outputPath, nlohmann::json& stats);
+
+    // 在内存中规范化；NAPI 调用点未保持不变时返回 false（此时模块已被修改，不应继续使用）
+    static bool canonicalize(llvm::Module& module, nlohmann::json& stats);
+};
+
+#endif // MODULE_CANONICALIZER_H
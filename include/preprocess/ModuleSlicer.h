@@ -0,0 +1,27 @@
+#ifndef MODULE_SLICER_H
+#define MODULE_SLICER_H
+
+#include <nlohmann/json.hpp>
+#include <llvm/IR/Module.h>
+#include <string>
+
+// SVF 构造前的模块切片：从 NAPI 入口出发，只保留可能被分析到的函数体。
+// 入口为调用 napi_module_register 的函数、napi_module 结构体中登记的初始化函数以及 napi_register_module_v1；
+// 从入口出发，沿指令操作数（直接调用、取地址的函数指针）与被引用全局变量的初始值（属性描述符数组等）
+// 传递闭包，napi_define_properties / napi_set_named_property / napi_create_function 登记的回调均在其中。
+// 其余函数的函数体被删除为声明，Andersen 与 SVFG 只处理相关的部分。
+// 找不到任何入口、或切片后模块校验失败时不做切片
+class ModuleSlicer {
+public:
+    // 环境变量 NAPI_SVF_MODULE_SLICE 为 0/false/off 时关闭
+    static bool isEnabled();
+
+    // 读取 inputPath，切片后以 bitcode 写入 outputPath；成功时返回 true，
+    // stats 记录切片前后的函数与指令数
+    static bool sliceToFile(const std::string& inputPath, const std::string& outputPath, nlohmann::json& stats);
+
+    // 在内存中切片，返回被删除函数体的个数；没有入口时不修改模块并返回 -1
+    static long slice(llvm::Module& module, nlohmann::json& stats);
+};
+
+#endif // MODULE_SLICER_H
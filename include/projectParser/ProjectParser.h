@@ -7,6 +7,7 @@
 #include <map>
 #include <nlohmann/json.hpp>
 #include <fstream>
+#include <functional>
 
 // 定义一个结构体来存储so库的信息
 struct LibraryInfo {
@@ -18,8 +19,16 @@ struct LibraryInfo {
 
 class ProjectParser {
 public:
+    // 每成功提取一个库的bitcode即调用一次，可用于在构建其余项目的同时开始分析
+    using LibraryCallback = std::function<void(const LibraryInfo& lib)>;
+
     // 构造函数，接收项目路径作为参数
     ProjectParser(const std::string& path);
+    ProjectParser(const std::string& path, const LibraryCallback& onLibrary);
+
+    // LibraryInfo 与JSON字符串互转，用于跨进程传递
+    static std::string encodeLibraryInfo(const LibraryInfo& lib);
+    static bool decodeLibraryInfo(const std::string& data, LibraryInfo& lib);
 
     // 设置CMake路径
     void setCMakePath(const std::string& path);
@@ -44,6 +53,10 @@ private:
     std::filesystem::path logDir;
     std::filesystem::path currentLogFile;
     mutable std::ofstream logStream; // 允许在const方法中写日志
+    LibraryCallback onLibrary;
+
+    // 编译所有CMake项目并提取bitcode
+    void parseProject();
 
     // 从路径中提取项目名称
     std::string extractProjectName(const std::filesystem::path& cmakeDir);
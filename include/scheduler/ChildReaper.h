@@ -0,0 +1,85 @@
+#ifndef CHILD_REAPER_H
+#define CHILD_REAPER_H
+
+#include <sys/types.h>
+#include <signal.h>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 已回收的子进程
+struct ReapedChild {
+    pid_t pid;
+    std::string label;  // 登记时给出的名称，用于日志
+    bool completed;     // true: 子进程自行退出（正常或被信号终止）；false: 超时被强制终止
+    int status;         // waitpid 返回的状态
+    std::string output; // 子进程通过结果管道写出的全部字节
+    long maxRssKb;      // 子进程的峰值常驻内存（KB），来自 wait4 的 rusage
+};
+
+// 事件驱动的子进程回收器：
+// 通过 signalfd 接收 SIGCHLD，同时跟踪所有存活子进程，
+// 每个子进程拥有从各自 fork 时刻起算的绝对截止时间
+class ChildReaper {
+public:
+    ChildReaper();
+    ~ChildReaper();
+
+    ChildReaper(const ChildReaper&) = delete;
+    ChildReaper& operator=(const ChildReaper&) = delete;
+
+    // fork 之后立即登记子进程，timeoutSeconds <= 0 表示不限时；
+    // resultFd 为结果管道的读端（可选），回收器在等待期间持续读取，避免子进程写满管道阻塞
+    void watch(pid_t pid, int timeoutSeconds, const std::string& label, int resultFd = -1);
+
+    // 子进程在结果管道上输出新数据时调用；处理函数可从 buffer 头部取走已处理的字节，
+    // 剩余部分在回收时放入 ReapedChild::output
+    using OutputHandler = std::function<void(pid_t pid, std::string& buffer)>;
+    void setOutputHandler(const OutputHandler& handler) { outputHandler = handler; }
+
+    // 从当前时刻起重新计算子进程的截止时间（已开始终止的子进程不受影响）
+    void resetDeadline(pid_t pid, int timeoutSeconds);
+
+    // 在输出处理函数中调用：让当前的 waitAny 在处理完本轮事件后返回（可能返回空列表）
+    void requestWake() { wakeRequested = true; }
+
+    // 阻塞直到至少一个子进程结束（含超时被终止）或被 requestWake 唤醒，返回本轮结束的全部子进程
+    std::vector<ReapedChild> waitAny();
+
+    bool empty() const { return children.empty(); }
+    size_t size() const { return children.size(); }
+
+    // 在 fork 出的子进程中调用：关闭继承的 signalfd、结果管道并恢复信号屏蔽字
+    void detachInChild();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct WatchedChild {
+        std::string label;
+        bool hasDeadline;
+        Clock::time_point deadline;
+        bool terminating;             // 已发送 SIGTERM
+        bool killed;                  // 已发送 SIGKILL
+        Clock::time_point killDeadline;
+        int resultFd;                 // 结果管道读端，-1 表示无或已读到EOF
+        std::string output;           // 已读取的结果数据
+    };
+
+    int signalFd;
+    sigset_t previousMask;
+    std::unordered_map<pid_t, WatchedChild> children;
+    OutputHandler outputHandler;
+    bool wakeRequested;
+
+    // 回收所有已退出的子进程
+    void collectExited(std::vector<ReapedChild>& reaped);
+    // 读取子进程结果管道中当前可读的数据，读到EOF时关闭
+    void drainOutput(pid_t pid, WatchedChild& child);
+    // 处理到期的截止时间，返回距离下一个截止时间的毫秒数（-1 表示无限等待）
+    int enforceDeadlines();
+};
+
+#endif // CHILD_REAPER_H
@@ -0,0 +1,84 @@
+#ifndef LIBRARY_SCHEDULER_H
+#define LIBRARY_SCHEDULER_H
+
+#include "scheduler/ChildReaper.h"
+#include "scheduler/ResultChannel.h"
+#include <sys/types.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// 待调度的库分析任务
+struct LibraryJob {
+    std::string label;        // 日志中的名称
+    uint64_t bitcodeBytes;    // 输入 bitcode 的大小，用于估算内存占用
+};
+
+// 带内存准入控制的库级子进程调度器：
+// 按"固定开销 + bitcode 大小 × 已观测到的峰值RSS比例"估算每个库的内存占用，
+// 只有在预计总占用不超过上限时才启动新的库；没有库在运行时总会启动一个，保证不会饿死。
+// 任务可以预先通过 addJob 加入，也可以由一个"任务来源"子进程（如项目构建）边产生边加入
+class LibraryScheduler {
+public:
+    // 子进程中执行的任务，执行完毕后子进程直接退出；resultFd 为回传给父进程的结果管道写端
+    using ChildTask = std::function<void(size_t jobIndex, int resultFd)>;
+    // 父进程中在每个子进程结束后调用，child.output 为子进程写入结果管道的全部字节
+    using DoneCallback = std::function<void(size_t jobIndex, const ReapedChild& child)>;
+    // 任务来源子进程中执行，通过 resultFd 逐帧回传新任务的描述
+    using SourceTask = std::function<void(int resultFd)>;
+    // 父进程中收到任务来源的每一帧时调用，通常在其中调用 addJob
+    using SourceFrameCallback = std::function<void(const Frame& frame)>;
+
+    LibraryScheduler(size_t width, uint64_t memoryCapBytes, int timeoutSeconds);
+    ~LibraryScheduler();
+
+    LibraryScheduler(const LibraryScheduler&) = delete;
+    LibraryScheduler& operator=(const LibraryScheduler&) = delete;
+
+    // 默认并发宽度：环境变量 NAPI_SVF_LIBRARY_JOBS，未设置时为在线CPU核数
+    static size_t defaultWidth();
+    // 默认内存上限：环境变量 NAPI_SVF_MEM_CAP_MB，未设置时为物理内存的 80%
+    static uint64_t defaultMemoryCap();
+
+    // 加入一个任务，返回任务序号（从 0 开始按加入顺序编号）
+    size_t addJob(const LibraryJob& job);
+
+    // 运行任务直到所有已加入的任务完成且任务来源子进程已退出；source 为空时只运行预先加入的任务。
+    // 返回时所有子进程均已回收
+    void run(const SourceTask& source, const SourceFrameCallback& onSourceFrame,
+             const ChildTask& childTask, const DoneCallback& onDone);
+
+    size_t getWidth() const { return width; }
+    // 当前正在运行的库子进程数（至少为 1）。计数保存在与子进程共享的内存中，
+    // 库子进程随时读取即可得到最新值，据此决定自身的函数级并发宽度
+    size_t runningJobs() const;
+    uint64_t getMemoryCap() const { return memoryCapBytes; }
+    // 任务来源子进程从启动到退出的耗时（秒）
+    double getSourceSeconds() const { return sourceSeconds; }
+
+private:
+    struct RunningJob {
+        size_t jobIndex;
+        uint64_t estimatedBytes;
+    };
+
+    std::vector<LibraryJob> jobs;
+    std::vector<size_t> pending;    // 尚未启动的任务，按 bitcode 大小降序
+    size_t width;
+    uint64_t memoryCapBytes;
+    int timeoutSeconds;
+    double sourceSeconds;
+    // 扣除固定开销后的峰值RSS与bitcode大小之比，取已完成子进程中观测到的最大值
+    double bytesPerBitcodeByte;
+    // 运行中的库数，位于 fork 前映射的共享匿名内存；映射失败时为 nullptr
+    std::atomic<unsigned>* sharedRunning;
+
+    uint64_t estimate(const LibraryJob& job) const;
+    // 读取 /proc/<pid>/status 中的 VmRSS，读取失败时返回 0
+    static uint64_t currentRssBytes(pid_t pid);
+};
+
+#endif // LIBRARY_SCHEDULER_H
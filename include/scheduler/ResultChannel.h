@@ -0,0 +1,37 @@
+#ifndef RESULT_CHANNEL_H
+#define RESULT_CHANNEL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 子进程通过管道回传给父进程的消息类型
+enum class FrameType : uint8_t {
+    FunctionSummary = 1,   // SummaryCodec 编码的函数摘要
+    TaskBegin = 2,         // 批处理子进程开始执行某个任务，负载为 u32 任务序号
+    TaskEnd = 3,           // 批处理子进程完成某个任务，负载为 u32 任务序号
+    LibraryReady = 4,      // 项目构建子进程提取出一个库的bitcode，负载为 LibraryInfo 的JSON
+    Metrics = 5,           // 库或函数的指标记录，负载为 MetricsProbe 生成的JSON
+};
+
+// 一条完整的消息
+struct Frame {
+    FrameType type;
+    std::string payload;
+};
+
+// 管道上的消息分帧：1字节类型 + u32小端长度 + 负载
+class ResultChannel {
+public:
+    // 子进程：向写端写入一条完整消息（处理EINTR与短写）
+    static bool writeFrame(int fd, FrameType type, const std::string& payload);
+
+    // 父进程：从累计的字节流中解析所有完整消息，未完整的尾部留在 buffer 中
+    static std::vector<Frame> parseFrames(std::string& buffer);
+
+    // TaskBegin / TaskEnd 的负载编解码
+    static std::string encodeTaskIndex(uint32_t taskIndex);
+    static bool decodeTaskIndex(const std::string& payload, uint32_t& taskIndex);
+};
+
+#endif // RESULT_CHANNEL_H
@@ -0,0 +1,25 @@
+#ifndef TASK_OUTPUT_H
+#define TASK_OUTPUT_H
+
+#include <llvm/Support/raw_ostream.h>
+
+// 线程模式下按任务缓冲调试输出：任务执行期间，当前线程写入 std::cout（含 SVFUtil::outs()）
+// 与 TaskOutput::outs() 的内容先存入线程私有缓冲，任务结束时在互斥锁保护下整块写到标准输出，
+// 不同函数的输出不会交错。未处于缓冲中的线程照常直接输出
+class TaskOutput {
+public:
+    // 处理函数打印 LLVM 对象时使用的流：缓冲中返回线程私有的流，否则为 llvm::outs()
+    static llvm::raw_ostream& outs();
+
+    // 在一个任务的执行期间缓冲当前线程的输出，析构时整块写出
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+};
+
+#endif // TASK_OUTPUT_H
@@ -0,0 +1,26 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// 进程内的固定宽度线程池：width 个线程从共享计数器中依次领取任务，
+// 适用于共享同一份只读分析结果的任务
+class ThreadPool {
+public:
+    // workerIndex 为线程序号 [0, width)，可用于访问线程私有的状态
+    using Task = std::function<void(size_t workerIndex, size_t taskIndex)>;
+
+    // 运行 taskCount 个任务，返回时所有线程均已结束
+    static void parallelFor(size_t width, size_t taskCount, const Task& task);
+
+    // 在有向无环依赖图上运行任务：任务 i 在其 dependencyCounts[i] 个依赖全部完成后才开始，
+    // 完成后 dependents[i] 中的任务各减少一个未完成依赖。
+    // 每个线程优先从自己的队列尾部取出新就绪的任务（通常是刚完成任务的上层），
+    // 自己的队列为空时从其他线程的队列头部窃取。返回时所有线程均已结束
+    static void runDag(size_t width, const std::vector<std::vector<size_t>>& dependents,
+                       const std::vector<size_t>& dependencyCounts, const Task& task);
+};
+
+#endif // THREAD_POOL_H
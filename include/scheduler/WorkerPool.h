@@ -0,0 +1,70 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "scheduler/ResultChannel.h"
+#include <sys/types.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// 固定宽度的批处理子进程池：同一时刻最多运行 width 个子进程，
+// 每个子进程依次执行一批任务，批大小根据已测得的单任务耗时自适应调整。
+// 超时时间按任务计算：子进程每开始一个任务就重新计时；
+// 子进程崩溃或超时只影响当时正在执行的任务（单独重试，共最多 maxAttempts 次），其余未开始的任务重新排队。
+// 每次重试的超时时间减半，任务可据 attempt 在重试时降低分析代价，总耗时不超过原先"同样设置重试一次"
+class WorkerPool {
+public:
+    // 子进程中执行的单个任务，attempt 为此前已失败的次数（首次执行为 0），结果帧写入 resultFd（结果管道写端）
+    using ChildTask = std::function<void(size_t taskIndex, unsigned attempt, int resultFd)>;
+    // 父进程中在某个任务正常结束（收到其 TaskEnd）后，按顺序对它的每个结果帧调用；
+    // 未正常结束的任务的帧不会交出，重试成功后只交出最后一次执行的结果
+    using FrameCallback = std::function<void(size_t taskIndex, const Frame& frame)>;
+    // 任务单次执行的失败方式
+    enum class AttemptOutcome { TimedOut, Crashed };
+    // 任务最终失败的经过：attempts 按顺序记录每次已开始的执行如何失败；
+    // startFailed 表示最后未能开始执行（管道或子进程创建失败，或子进程多次在该任务开始前退出）
+    struct TaskFailure {
+        std::vector<AttemptOutcome> attempts;
+        bool startFailed = false;
+    };
+    // 任务重试后仍失败或无法开始执行时调用
+    using FailureCallback = std::function<void(size_t taskIndex, const TaskFailure& failure)>;
+
+    WorkerPool(size_t width, int timeoutSeconds, const std::string& processName, unsigned maxAttempts = 2);
+
+    // 宽度的取值来源，返回值为 0 时按 1 处理
+    using WidthSource = std::function<size_t()>;
+
+    // 单个库内函数分析的默认宽度：环境变量 NAPI_SVF_JOBS；未设置时把在线CPU核数平分给
+    // 当前同时运行的 runningLibraries 个库（至少为 1），库级与函数级并发合计不超过核数
+    static size_t defaultWidth(size_t runningLibraries = 1);
+
+    // 宽度随运行环境变化时设置（如其他库结束后可用的核变多），每次启动子进程前重新取值；
+    // 宽度变小时已运行的子进程不受影响，只是暂不启动新的子进程
+    void setWidthSource(const WidthSource& source) { widthSource = source; }
+
+    // 运行 taskCount 个任务，返回时所有子进程均已回收
+    void run(size_t taskCount, const ChildTask& childTask, const FrameCallback& onFrame, const FailureCallback& onFailure);
+
+    size_t getWidth() const;
+
+private:
+    size_t width;
+    WidthSource widthSource;
+    int timeoutSeconds;
+    std::string processName;
+    unsigned maxAttempts;      // 每个任务最多执行的次数（首次 + 重试）
+    size_t maxBatchSize;       // NAPI_SVF_BATCH_MAX，1 表示每个任务单独一个子进程
+    double targetBatchMs;      // NAPI_SVF_BATCH_TARGET_MS，单个批次期望的执行时长
+    double averageTaskMs;      // 单任务耗时的指数滑动平均
+    bool hasTaskSample;
+
+    // 根据平均耗时与剩余任务数决定下一批的大小
+    size_t nextBatchSize(size_t remainingTasks) const;
+    void recordTaskCost(double elapsedMs);
+    // 第 attempt 次执行（从 0 开始）的超时时间
+    int timeoutFor(unsigned attempt) const;
+};
+
+#endif // WORKER_POOL_H
@@ -0,0 +1,47 @@
+#ifndef ANALYSIS_BUDGET_H
+#define ANALYSIS_BUDGET_H
+
+#include <cstddef>
+
+// 单个函数分析的预算档位。函数超时（fork 模式下还包括崩溃）后按更低的档位重试，尽量为每个函数都给出（较粗的）摘要：
+//   full     不额外限制（首次分析）
+//   reduced  bfsPredecessors 限制反向遍历深度，getCalledFunctions 限制被调函数的展开深度
+//   minimal  两个深度上限再减半，且 getExistingNodes 不再回退到别名查询
+// 组合式摘要模式（NAPI_SVF_SUMMARY_MODE=compositional）下被调函数的摘要在分析导出函数之前一次算好，调用点只做实例化，
+// 因此被调函数展开深度不起作用，降级只体现在反向遍历深度与别名回退上；摘要预计算本身按强连通分量走同一套档位阶梯；
+// 被调函数展开深度只约束默认的 inline 模式下的 getCalledFunctions。
+// 档位与截止时间按线程各自保存，子进程或线程在分析函数前设置。
+// 截止时间是线程模式下的协作式超时：到期后反向遍历与调用点处理提前结束，调用方据 expired() 丢弃结果并降档重试。
+// 深度上限由环境变量配置：
+//   NAPI_SVF_DEGRADED_SLICE_DEPTH   reduced 档位的反向遍历深度（默认 16）
+//   NAPI_SVF_DEGRADED_CALLEE_DEPTH  reduced 档位的被调函数展开深度（默认 2，1 表示只处理函数自身的调用点；仅 inline 模式）
+class AnalysisBudget {
+public:
+    enum Level { Full = 0, Reduced = 1, Minimal = 2 };
+    static const unsigned LEVEL_COUNT = 3;
+
+    // 超出范围的档位按 minimal 处理；同时把结果档位重置为该档位
+    static void setLevel(unsigned level);
+    static Level level();
+    static const char* levelName(Level level);
+
+    // 结果档位：当前分析所依赖的最低档位。实例化以较低档位得出的被调函数摘要时经 noteLevel 记下，
+    // 导出函数的摘要据此标注档位，依赖降级摘要的结果同样不写入增量清单
+    static void noteLevel(Level used);
+    static Level resultLevel();
+
+    // 第 level 档的时限：每降一档减半，至少 1 秒；baseSeconds <= 0（不限时）时原样返回
+    static int timeoutFor(int baseSeconds, unsigned level);
+
+    // 0 表示不限制
+    static size_t maxSliceDepth();
+    static size_t maxCalleeDepth();
+    static bool aliasFallback();
+
+    // 从现在起 seconds 秒后到期（seconds <= 0 表示不限时）；expired() 一旦返回 true，在下次设置前保持为 true
+    static void setDeadline(int seconds);
+    static void clearDeadline();
+    static bool expired();
+};
+
+#endif // ANALYSIS_BUDGET_H
@@ -0,0 +1,28 @@
+#ifndef CALLEESUMMARY_H
+#define CALLEESUMMARY_H
+
+#include "taintanalysis/SummaryItem.h"
+#include "taintanalysis/AnalysisBudget.h"
+#include "SVFIR/SVFIR.h"
+#include <utility>
+#include <vector>
+
+// 内部函数的可复用摘要：以被调函数自身的形参为起点分析得到，
+// 其中的 "%n" 编号在调用点重新映射到调用者的编号空间
+struct CalleeSummary {
+    std::vector<int> paramIds;     // 第 i 个形参对应的编号，-1 表示无
+    int envId = -1;                // napi_env / napi_callback_info 的占位编号，实例化时映射为调用者的对应编号
+    int callbackInfoId = -1;
+    int idCount = 0;               // 摘要中使用的编号个数，编号范围为 [0, idCount)
+    std::vector<SummaryItem> items;  // 被调函数及其闭包中产生的摘要指令，按调用点顺序排列
+    // 分析过程中建立的 SVF 节点 -> 编号绑定，实例化后调用者的处理函数仍能通过节点查到这些编号
+    std::vector<std::pair<SVF::NodeID, std::vector<int>>> nodeBindings;
+    std::vector<std::pair<int, std::vector<int>>> valueFlows;  // 编号之间的传值关系
+    // 得出该摘要的预算档位（含其依赖的被调函数摘要）；各档位均超时的函数摘要为空，档位记为 minimal
+    AnalysisBudget::Level level = AnalysisBudget::Full;
+
+    // 不产生任何摘要指令的函数在调用点无需实例化
+    bool isEmpty() const { return items.empty(); }
+};
+
+#endif // CALLEESUMMARY_H
@@ -0,0 +1,17 @@
+#ifndef FUNCTIONSUMMARY_H
+#define FUNCTIONSUMMARY_H
+
+#include "taintanalysis/SummaryItem.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+// 单个导出函数的分析结果，Traceker 的结构化形式
+struct FunctionSummary {
+    std::string name;                                       // 导出名称
+    std::vector<std::pair<std::string, std::string>> params; // "%id" -> 参数名
+    std::vector<SummaryItem> items;                         // 摘要指令序列
+    std::string budget;                                     // 得出该摘要的预算档位（AnalysisBudget）
+};
+
+#endif // FUNCTIONSUMMARY_H
@@ -0,0 +1,18 @@
+#ifndef SUMMARYCODEC_H
+#define SUMMARYCODEC_H
+
+#include "taintanalysis/FunctionSummary.h"
+#include <string>
+
+// FunctionSummary 的紧凑二进制编码，用于子进程向父进程回传结果
+// 格式：所有整数为 u32 小端，字符串为 长度 + 字节
+class SummaryCodec {
+public:
+    // 追加编码结果到 out
+    static void encode(const FunctionSummary& summary, std::string& out);
+
+    // 解码，数据不完整或格式错误时返回 false
+    static bool decode(const char* data, size_t size, FunctionSummary& summary);
+};
+
+#endif // SUMMARYCODEC_H
@@ -0,0 +1,65 @@
+#ifndef SUMMARYENGINE_H
+#define SUMMARYENGINE_H
+
+#include "taintanalysis/CalleeSummary.h"
+#include "taintanalysis/TaintMap.h"
+#include "taintanalysis/SummaryItem.h"
+#include "SVFIR/SVFIR.h"
+#include "WPA/Andersen.h"
+#include "Graphs/SVFG.h"
+#include "metrics/Metrics.h"
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+#include <unordered_map>
+#include <vector>
+
+// 组合式摘要引擎：按调用图的强连通分量自底向上，为每个库中的内部函数只分析一次，
+// 导出函数分析时在调用点实例化被调函数的摘要，不再重复遍历被调函数的函数体。
+// 互不依赖的强连通分量由多个线程并行计算，每个分量的结果只取决于其被调分量的摘要，与调度顺序无关。
+// build 完成后只读，可被多个线程共享，也可在 fork 出的子进程中继续使用
+class SummaryEngine {
+public:
+    SummaryEngine(SVF::SVFIR* pag, SVF::AndersenBase* ander, SVF::SVFG* svfg);
+
+    // 环境变量 NAPI_SVF_SUMMARY_MODE 为 compositional 时开启；默认 inline，逐个导出函数展开整个调用闭包。
+    // 两种方式的结果并不完全相同：实例化时每个调用点为未绑定的实参分配新编号、递归分量中尚未完成的成员
+    // 在调用点被跳过、不产生摘要指令的被调函数不带回其节点绑定。在真实库上确认两者等价之前保持默认关闭
+    static bool isEnabled();
+
+    // 为 roots 调用闭包中被调用到的全部函数计算摘要，width 为并行线程数；
+    // 并行前须已调用 TaintTracker::prepareForConcurrentQueries。返回各线程计数器之和。
+    // 每个强连通分量与导出函数一样按 AnalysisBudget 的档位阶梯计算：超过 timeoutSeconds（每降一档减半）
+    // 则按下一档重算，各档均超时的分量摘要置空，单个病态的被调函数不会拖住整个库
+    MetricCounters build(const std::vector<const llvm::Function*>& roots, size_t width, int timeoutSeconds);
+
+    // 函数的摘要，未计算（如声明、递归中尚未完成的函数）时返回 nullptr
+    const CalleeSummary* lookup(const llvm::Function* func) const;
+
+    // 依次处理 func 自身的调用点：NAPI 调用交给处理函数，内部函数调用实例化其摘要；
+    // 调用点按出现顺序追加到 callSites（可为 nullptr）
+    void processCallSites(const llvm::Function* func, TaintMap& taintMap, std::vector<SummaryItem>& summaryItems,
+                          std::vector<const llvm::Instruction*>* callSites) const;
+
+    // 在调用点把被调函数的摘要实例化到调用者的编号空间
+    void instantiate(const CalleeSummary& summary, const llvm::CallBase* callSite, TaintMap& taintMap,
+                     std::vector<SummaryItem>& summaryItems) const;
+
+    // 直接调用或经指针转换后调用的函数
+    static const llvm::Function* resolveCallee(const llvm::CallBase* callSite);
+
+    size_t size() const { return slots.size(); }
+
+private:
+    SVF::SVFIR* pag;
+    SVF::AndersenBase* ander;
+    SVF::SVFG* svfg;
+    // 按自底向上的顺序排列的摘要槽位；并行计算期间槽位集合不变，
+    // 各槽位只由负责其分量的线程写入，依赖它的分量在其完成之后才开始读取
+    std::unordered_map<const llvm::Function*, size_t> slotOf;
+    std::vector<CalleeSummary> slots;
+    std::vector<char> slotReady;
+
+    CalleeSummary summarize(const llvm::Function* func) const;
+};
+
+#endif // SUMMARYENGINE_H
@@ -12,9 +12,9 @@
 class TaintList {
 public:
     // 构造函数
-    TaintList(SVF::Andersen* ander, const std::vector<TaintUnit>& taintUnits); 
+    TaintList(SVF::AndersenBase* ander, const std::vector<TaintUnit>& taintUnits); 
 
-    TaintList(SVF::Andersen* ander, const std::vector<TaintUnit>& taintUnits, std::string function_Name, std::vector<SVF::NodeID> function_ParamNodeIDs);
+    TaintList(SVF::AndersenBase* ander, const std::vector<TaintUnit>& taintUnits, std::string function_Name, std::vector<SVF::NodeID> function_ParamNodeIDs);
 
     // 处理TaintUnit数组，提取napi相关函数
     void processTargetUnits();  // 修改方法名
@@ -58,7 +58,7 @@ private:
     std::map<SVF::NodeID, unsigned int> nodeIDMap; 
 
     // Andersen指针分析
-    SVF::Andersen* ander;
+    SVF::AndersenBase* ander;
 
     // 整体函数名称
     std::string function_Name;
@@ -25,6 +25,22 @@ private:
     std::unordered_map<int, std::vector<SVF::NodeID>> newIdToNode;
     std::vector<ParamInfo> paramIds;
     SVF::PointerAnalysis* pta;
+    // napi_env 与 napi_callback_info 对应的编号：默认为导出函数的前两个参数，
+    // 被调函数的摘要中为不绑定节点的占位编号（见 reserveRootParamIds）
+    int envId;
+    int callbackInfoId;
+
+    // 别名查找的反向索引：抽象对象 -> 指向集含该对象的表项（nodeToNewIds 的键），
+    // 可能别名的判断由逐表项的 alias 查询变为指向集中各对象的索引查找
+    std::unordered_map<SVF::NodeID, std::vector<SVF::NodeID>> objectToKeys;
+    std::vector<SVF::NodeID> blackHoleKeys;                // 指向集含黑洞节点的表项，与任何节点都可能别名
+    std::unordered_map<SVF::NodeID, size_t> keyOrder;      // 表项加入的先后顺序
+
+    // 返回 node 的表项，不存在时插入空表项并登记到反向索引；所有插入表项的路径都经过这里
+    std::vector<int>& entryFor(SVF::NodeID node);
+    SVF::PointsTo expandedPts(SVF::NodeID node) const;
+    // 与 node 可能别名的全部表项，按加入顺序排列
+    std::vector<SVF::NodeID> findAliasKeys(SVF::NodeID node) const;
 
 public:
     TaintMap();
@@ -58,16 +74,38 @@ public:
 
     void addValueFlowSource(int dest, int source);
 
-    std::vector<SVF::NodeID> getExistingNodes(std::vector<SVF::NodeID>& nodes, SVF::Andersen* ander);
+    std::vector<SVF::NodeID> getExistingNodes(std::vector<SVF::NodeID>& nodes, SVF::AndersenBase* ander);
     
     // 获取参数信息
     const std::vector<ParamInfo>& getParamIds() const { return paramIds; }
     
     // 根据参数位置获取对应的paramId
     int getParamIdByIndex(size_t index) const;
+
+    // 处理函数为 env / cbinfo 操作数使用的编号，不存在时为 -1
+    int getEnvId() const { return envId; }
+    int getCallbackInfoId() const { return callbackInfoId; }
+
+    // 以被调函数自身的形参为起点计算摘要时调用：env 与 cbinfo 来自调用链的根（导出函数），
+    // 而被调函数的前两个形参可能是 this、结构体或其他参数，因此为两者分配占位编号，实例化时再映射到调用者的编号
+    void reserveRootParamIds();
     
     // 检查nodeID是否与paramIds中的节点可能是别名，如果是则返回对应的paramId
-    int getParamIdIfAlias(SVF::NodeID nodeID, SVF::Andersen* ander) const;
+    int getParamIdIfAlias(SVF::NodeID nodeID, SVF::AndersenBase* ander) const;
+
+    // 以下接口供 SummaryEngine 导出被调函数摘要并在调用点实例化
+
+    // 分配一个不绑定任何节点的新编号
+    int allocateId();
+
+    // 已分配的编号个数（编号从 0 开始连续分配）
+    int getIdCount() const { return counter; }
+
+    const std::unordered_map<SVF::NodeID, std::vector<int>>& getNodeBindings() const { return nodeToNewIds; }
+    const std::unordered_map<int, std::vector<int>>& getValueFlows() const { return valueFlowMap; }
+
+    // node 尚无编号时绑定为 newIds，已有编号时保持不变
+    void bindIfAbsent(SVF::NodeID node, const std::vector<int>& newIds);
 };
 
 #endif // TAINTMAP_H
\ No newline at end of file
@@ -16,33 +16,53 @@
 #include <unordered_map>
 #include <queue>
 #include "taintanalysis/TaintMap.h"
+#include "taintanalysis/FunctionSummary.h"
 #include <nlohmann/json.hpp>
+
+class SummaryEngine;
+class AnalysisContext;
+
 class TaintTracker {
 
 private:
     SVF::PAG* pag;
-    SVF::Andersen* ander;
+    SVF::AndersenBase* ander;
     SVF::SVFG* svfg;
-    SVF::VFG* vfg;    
+    AnalysisContext* context;   // 独立的 VFG 经由上下文按需构建，见 getVFG
     std::set<SVF::NodeID> taintedNodes;
     std::unordered_map<SVF::NodeID, std::vector<SVF::NodeID>> nodeIDMap;
     std::queue<SVF::NodeID> worklist;
     std::set<SVF::NodeID> visitedNodes;
-    std::vector<const llvm::Function*> targetedfunctions;
-    std::vector<const llvm::Instruction*> targetedinst;
+    bool verbose;   // 是否打印调用链上的指令与节点详情，多线程模式下关闭
+    const SummaryEngine* summaryEngine;   // 非空时在调用点实例化被调函数的摘要，不再展开整个调用闭包
 
 public:
     
-    TaintTracker(SVF::PAG* pag, SVF::Andersen* ander, SVF::SVFG* svfg, SVF::VFG* vfg);
+    explicit TaintTracker(AnalysisContext& context);
+
+    // 首次调用时才构建独立的 VFG
+    SVF::VFG* getVFG();
+
+    // 多线程共享同一份 SVF 图之前调用：预先触发指针分析中按需插入的查询表项，
+    // 之后并发的 getPts/alias 查询只读不写
+    static void prepareForConcurrentQueries(SVF::PAG* pag, SVF::AndersenBase* ander);
+
+    void setVerbose(bool enabled) { verbose = enabled; }
+    void setSummaryEngine(const SummaryEngine* engine) { summaryEngine = engine; }
     
     // 检查指定节点是否被污染
     bool isTainted(SVF::NodeID id) const;
     void initializeFunctionArgs(const llvm::Function* func);
     nlohmann::json Traceker(const llvm::Function* func, std::vector<std::pair<SVF::NodeID, std::string>> paramNodeIDs, std::string funcName);
+    // 与Traceker相同，但返回结构化摘要，便于二进制回传
+    FunctionSummary traceSummary(const llvm::Function* func, std::vector<std::pair<SVF::NodeID, std::string>> paramNodeIDs, std::string funcName);
 
     bool isInstructionTainted(const llvm::Instruction* inst);
 
-    std::vector<const llvm::Function*> getCalledFunctions(const llvm::Function* F, std::set<const llvm::Function*>& visited);
+    // 收集 F 及其直接/间接被调函数，调用点按遍历顺序追加到 callSites；
+    // depth 为 F 相对导出函数的调用深度，降级重试时超过 AnalysisBudget::maxCalleeDepth() 的被调函数不再展开
+    std::vector<const llvm::Function*> getCalledFunctions(const llvm::Function* F, std::set<const llvm::Function*>& visited,
+                                                          std::vector<const llvm::Instruction*>& callSites, size_t depth = 0);
     TaintUnit handleDirectAssignment(const llvm::Instruction* inst);
     TaintUnit handlePhiInstruction(const llvm::Instruction* inst);
     TaintUnit handleReturnInstruction(const llvm::Instruction* inst);
@@ -63,6 +63,21 @@ json SummaryExporter::toJson(const std::vector<SummaryItem>& summaryItems) {
     return j; // 使用4个空格缩进美化输出
 }
 
+json SummaryExporter::toJson(const FunctionSummary& summary) {
+    json result;
+    result["name"] = summary.name;
+    json paramsJson;
+    for (const auto& param : summary.params) {
+        paramsJson[param.first] = param.second;
+    }
+    result["params"] = paramsJson;
+    result["instructions"] = toJson(summary.items);
+    if (!summary.budget.empty()) {
+        result["analysis_budget"] = summary.budget;
+    }
+    return result;
+}
+
 
 void SummaryExporter::exportToFile(const std::vector<SummaryItem>& summaryItems, const std::string& filename) {
     std::string fullPath = "result/" + filename;
@@ -0,0 +1,118 @@
+#include "cache/SVFCache.h"
+#include "config/EnvConfig.h"
+#include "Util/Options.h"
+#include "Util/CommandLine.h"
+#include "Util/SVFUtil.h"
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/xxhash.h>
+#include <unistd.h>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+using namespace SVF;
+namespace fs = std::filesystem;
+
+namespace {
+    // 缓存格式或分析配置变化时递增，使旧缓存自然失效
+    const char* CACHE_FORMAT_VERSION = "1";
+
+    std::string toHex(uint64_t value) {
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016" PRIx64, value);
+        return std::string(buffer);
+    }
+
+    // 影响 Andersen 结果的分析配置
+    std::string optionsFingerprint() {
+        std::string fingerprint = "v";
+        fingerprint += CACHE_FORMAT_VERSION;
+        fingerprint += ";pta=AndersenWaveDiff";
+        fingerprint += ";field-limit=" + std::to_string(Options::MaxFieldLimit());
+        fingerprint += ";model-consts=" + std::to_string(Options::ModelConsts());
+        fingerprint += ";model-arrays=" + std::to_string(Options::ModelArrays());
+        return fingerprint;
+    }
+}
+
+bool SVFCache::isEnabled() {
+    return EnvConfig::getBool("NAPI_SVF_CACHE", true);
+}
+
+std::string SVFCache::cacheDir() {
+    return EnvConfig::getString("NAPI_SVF_CACHE_DIR", (fs::current_path() / "result" / ".svf_cache").string());
+}
+
+std::string SVFCache::computeKey(const std::string& bitcodePath) {
+    auto buffer = llvm::MemoryBuffer::getFile(bitcodePath);
+    if (!buffer) {
+        return "";
+    }
+    uint64_t contentHash = llvm::xxHash64((*buffer)->getBuffer());
+    uint64_t optionsHash = llvm::xxHash64(optionsFingerprint());
+    return toHex(contentHash) + "-" + toHex(optionsHash);
+}
+
+std::string SVFCache::anderPath(const std::string& key) {
+    return (fs::path(cacheDir()) / (key + ".ander")).string();
+}
+
+std::string SVFCache::pendingAnderPath(const std::string& key) {
+    // 以 PID 区分，多个进程同时分析相同 bitcode 时互不覆盖
+    return anderPath(key) + ".tmp." + std::to_string(getpid());
+}
+
+void SVFCache::setAnderOptions(const std::string& readPath, const std::string& writePath) {
+    std::vector<std::string> args = {
+        "napi_svf_tool",
+        "-read-ander=" + readPath,
+        "-write-ander=" + writePath,
+    };
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(&arg[0]);
+    }
+    OptionBase::parseOptions(static_cast<int>(argv.size()), argv.data(), "napi_svf_tool", "[options]");
+}
+
+bool SVFCache::prepareAndersen(const std::string& key) {
+    // 两个选项总是成对设置，避免同一进程中沿用上一个库的路径。
+    // SVF 只要 -write-ander 非空就会在分析结束后写出结果（读取缓存成功时也一样），
+    // 因此只在未命中时指定临时文件，命中时置空，不再重复写出整份结果。
+    // 缓存不可用时读取路径指向一个永不创建的文件，同样不写出
+    std::error_code ec;
+    fs::create_directories(cacheDir(), ec);
+    if (key.empty() || ec) {
+        if (ec) {
+            SVFUtil::errs() << "无法创建SVF缓存目录: " << cacheDir() << "\n";
+        }
+        std::string unused = (fs::path(cacheDir()) / ".disabled.ander").string();
+        setAnderOptions(unused, "");
+        return false;
+    }
+
+    std::string cached = anderPath(key);
+    bool hit = fs::exists(cached, ec) && fs::file_size(cached, ec) > 0;
+    SVFUtil::outs() << (hit ? "命中SVF缓存: " : "未命中SVF缓存，求解后写入: ") << cached << "\n";
+    setAnderOptions(cached, hit ? "" : pendingAnderPath(key));
+    return hit;
+}
+
+void SVFCache::commitAndersen(const std::string& key) {
+    if (key.empty()) {
+        return;
+    }
+    // 命中时 prepareAndersen 没有设置写出路径，不会产生临时文件，这里无事可做
+    std::error_code ec;
+    std::string pending = pendingAnderPath(key);
+    if (!fs::exists(pending, ec)) {
+        return;
+    }
+    fs::rename(pending, anderPath(key), ec);
+    if (ec) {
+        fs::remove(pending, ec);
+    } else {
+        SVFUtil::outs() << "写入SVF缓存: " << anderPath(key) << "\n";
+    }
+}
@@ -0,0 +1,240 @@
+#include "core/AnalysisContext.h"
+#include "SVF-LLVM/LLVMModule.h"
+#include "SVF-LLVM/SVFIRBuilder.h"
+#include "Util/Options.h"
+#include "WPA/Steensgaard.h"
+#include "cache/SVFCache.h"
+#include "config/EnvConfig.h"
+#include "metrics/Metrics.h"
+#include "napi/NapiCallSiteIndex.h"
+#include "napi/NapiHandler.h"
+#include "napi/utils/VFGIndex.h"
+#include "preprocess/ModuleCanonicalizer.h"
+#include "preprocess/ModuleSlicer.h"
+#include <unistd.h>
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+using namespace SVF;
+
+namespace {
+    nlohmann::json pagCounts(const SVFIR* pag) {
+        nlohmann::json counts;
+        counts["nodes"] = pag->getTotalNodeNum();
+        counts["edges"] = pag->getTotalEdgeNum();
+        return counts;
+    }
+
+    // 单独加载一次模块并构建 PAG，只取其规模，随后释放
+    nlohmann::json measurePAG(const std::string& bitcodePath) {
+        LLVMModuleSet::buildSVFModule(std::vector<std::string>{bitcodePath});
+        SVFIRBuilder builder;
+        nlohmann::json counts = pagCounts(builder.build());
+        SVFIR::releaseSVFIR();
+        LLVMModuleSet::releaseLLVMModuleSet();
+        return counts;
+    }
+
+    uintmax_t fileSize(const std::string& path) {
+        std::error_code ec;
+        uintmax_t size = std::filesystem::file_size(path, ec);
+        return ec ? 0 : size;
+    }
+
+    // 预处理产生的中间 bitcode 写到临时目录（TMPDIR，默认 /tmp），不落在输入文件旁边；
+    // 以 PID 区分，多个进程同时分析同名的库时互不覆盖
+    std::string scratchPath(const std::string& bitcodePath, const std::string& suffix) {
+        std::error_code ec;
+        std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+        if (ec) {
+            dir = std::filesystem::current_path();
+        }
+        std::string name = std::filesystem::path(bitcodePath).filename().string();
+        return (dir / (name + "." + std::to_string(getpid()) + suffix)).string();
+    }
+}
+
+AnalysisTier AnalysisContext::selectTier(uintmax_t bitcodeBytes, size_t pagNodes) {
+    const std::string forced = EnvConfig::getString("NAPI_SVF_ANALYSIS_TIER", "auto");
+    if (forced == "full") {
+        return AnalysisTier::Full;
+    }
+    if (forced == "ptr_only") {
+        return AnalysisTier::PtrOnly;
+    }
+    if (forced == "unification") {
+        return AnalysisTier::Unification;
+    }
+    // 阈值为 0 时该项不参与判断
+    auto exceeds = [](uintmax_t value, long limit) { return limit > 0 && value > static_cast<uintmax_t>(limit); };
+    const uintmax_t bitcodeMb = bitcodeBytes / (1024 * 1024);
+    if (exceeds(bitcodeMb, EnvConfig::getLong("NAPI_SVF_TIER_UNIFICATION_MB", 256)) ||
+        exceeds(pagNodes, EnvConfig::getLong("NAPI_SVF_TIER_UNIFICATION_PAG_NODES", 8000000))) {
+        return AnalysisTier::Unification;
+    }
+    if (exceeds(bitcodeMb, EnvConfig::getLong("NAPI_SVF_TIER_PTR_ONLY_MB", 64)) ||
+        exceeds(pagNodes, EnvConfig::getLong("NAPI_SVF_TIER_PTR_ONLY_PAG_NODES", 2000000))) {
+        return AnalysisTier::PtrOnly;
+    }
+    return AnalysisTier::Full;
+}
+
+const char* AnalysisContext::tierName(AnalysisTier tier) {
+    switch (tier) {
+        case AnalysisTier::PtrOnly:
+            return "ptr_only";
+        case AnalysisTier::Unification:
+            return "unification";
+        default:
+            return "full";
+    }
+}
+
+AnalysisContext::AnalysisContext(const std::string& bitcodePath) {
+    // 先把模块切到 NAPI 入口可达的函数，后续的 PAG、指针分析与缓存键都基于切片后的模块。
+    // ir_annotator 模式需要在原模块上回写注解，不做切片
+    std::string analyzedPath = bitcodePath;
+    std::vector<std::string> scratchFiles;   // 预处理写出的中间 bitcode，SVF 加载后删除
+    const bool annotate = Options::WriteAnder() == "ir_annotator";
+    if (!annotate && ModuleSlicer::isEnabled()) {
+        std::string slicedPath = scratchPath(bitcodePath, ".sliced.bc");
+        scratchFiles.push_back(slicedPath);
+        nlohmann::json stats;
+        if (ModuleSlicer::sliceToFile(bitcodePath, slicedPath, stats)) {
+            analyzedPath = slicedPath;
+        }
+        stats["applied"] = analyzedPath != bitcodePath;
+        preprocessing["module_slice"] = stats;
+    }
+    // 可选的规范化（mem2reg/SROA 等）；开启统计时额外构建一次规范化前的 PAG 记录其规模
+    bool measureCanonicalization = false;
+    if (!annotate && ModuleCanonicalizer::isEnabled()) {
+        std::string canonicalPath = scratchPath(bitcodePath, ".canon.bc");
+        scratchFiles.push_back(canonicalPath);
+        nlohmann::json stats;
+        bool canonicalized = ModuleCanonicalizer::canonicalizeToFile(analyzedPath, canonicalPath, stats);
+        if (canonicalized) {
+            measureCanonicalization = ModuleCanonicalizer::measurePAGEnabled();
+            if (measureCanonicalization) {
+                stats["pag_before"] = measurePAG(analyzedPath);
+            }
+            analyzedPath = canonicalPath;
+        }
+        stats["applied"] = canonicalized;
+        preprocessing["canonicalize"] = stats;
+    }
+
+    std::vector<std::string> moduleNameVec;
+    moduleNameVec.push_back(analyzedPath);
+
+    if (annotate) {
+        LLVMModuleSet::preProcessBCs(moduleNameVec);
+    }
+
+    LLVMModuleSet::buildSVFModule(moduleNameVec);
+    // SVF 已把模块读入内存，此后不再需要中间文件；大小与缓存键先行取得
+    const uintmax_t analyzedBytes = fileSize(analyzedPath);
+    const bool cacheEnabled = SVFCache::isEnabled();
+    const std::string cacheKey = cacheEnabled ? SVFCache::computeKey(analyzedPath) : "";
+    scratchInput = analyzedPath != bitcodePath;
+    for (const std::string& path : scratchFiles) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+    // 调用点索引与被调函数到 NAPI 处理函数的映射在加载时一次性建立
+    NapiCallSiteIndex::getInstance().build();
+    NapiHandler::getInstance().bindModules();
+
+    /// Build Program Assignment Graph (SVFIR)
+    SVFIRBuilder builder;
+    pag = builder.build();
+    if (measureCanonicalization) {
+        preprocessing["canonicalize"]["pag_after"] = pagCounts(pag);
+    }
+
+    /// Select the precision tier
+    // 按 bitcode 大小与 PAG 节点数选择精度：完整 SVFG、仅指针的 SVFG，或基于合一的 Steensgaard。
+    // 大库宁可得到较粗的摘要，也不要在指针分析阶段超时
+    tier = selectTier(analyzedBytes, pag->getTotalNodeNum());
+    SVFUtil::outs() << "分析精度: " << tierName(tier) << "（PAG 节点数 " << pag->getTotalNodeNum() << "）\n";
+
+    /// Create the pointer analysis
+    if (tier == AnalysisTier::Unification) {
+        // 缓存只保存 Andersen 的结果；这里让 -read-ander 指向不存在的文件，避免读到上一个库的缓存
+        if (cacheEnabled) {
+            SVFCache::prepareAndersen("");
+        }
+        ander = Steensgaard::createSteensgaard(pag);
+    } else {
+        // bitcode 与分析选项均未变化时直接读取上次的指针分析结果，跳过约束求解
+        if (cacheEnabled) {
+            anderCacheHit = SVFCache::prepareAndersen(cacheKey);
+        }
+        ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
+        if (!cacheKey.empty()) {
+            SVFCache::commitAndersen(cacheKey);
+        }
+    }
+
+    /// Call Graph
+    callGraph = ander->getCallGraph();
+
+    /// Sparse value-flow graph (SVFG)
+    svfgBuilder = std::make_unique<SVFGBuilder>();
+    svfg = tier == AnalysisTier::Full ? svfgBuilder->buildFullSVFG(ander) : svfgBuilder->buildPTROnlySVFG(ander);
+    // 语句节点与 Addr/Store 节点的反向索引，处理函数回溯变量、解析整型常量时不再扫描全图
+    VFGIndex::build(svfg, ander);
+
+    /// Value-Flow Graph (VFG)
+    // 污点分析只使用 SVFG，独立的 VFG 默认推迟到首次查询时构建
+    eagerVFG = EnvConfig::getBool("NAPI_SVF_EAGER_VFG", false);
+    if (eagerVFG) {
+        getVFG();
+    }
+}
+
+VFG* AnalysisContext::getVFG() {
+    std::call_once(vfgOnce, [this]() {
+        long rssBefore = Metrics::currentRssKb();
+        auto start = std::chrono::steady_clock::now();
+        vfg = new VFG(callGraph);
+        vfgBuildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        vfgRssDeltaKb = Metrics::currentRssKb() - rssBefore;
+    });
+    return vfg;
+}
+
+nlohmann::json AnalysisContext::vfgStats() const {
+    nlohmann::json stats;
+    stats["vfg_mode"] = eagerVFG ? "eager" : "lazy";
+    stats["vfg_built"] = vfg != nullptr;
+    stats["vfg_construction_time_seconds"] = vfgBuildSeconds;
+    stats["vfg_rss_delta_mb"] = static_cast<double>(vfgRssDeltaKb) / 1024.0;
+    return stats;
+}
+
+AnalysisContext::~AnalysisContext() {
+    // 依赖关系的逆序：索引 -> 值流图 -> 指针分析 -> PAG -> LLVM 模块
+    VFGIndex::release(svfg);
+    svfgBuilder.reset();
+    svfg = nullptr;
+    delete vfg;
+    vfg = nullptr;
+    if (tier == AnalysisTier::Unification) {
+        Steensgaard::releaseSteensgaard();
+    } else {
+        AndersenWaveDiff::releaseAndersenWaveDiff();
+    }
+    ander = nullptr;
+    callGraph = nullptr;
+    SVFIR::releaseSVFIR();
+    pag = nullptr;
+    // 预处理后的模块只存在于临时目录，不再导出
+    if (!scratchInput) {
+        LLVMModuleSet::getLLVMModuleSet()->dumpModulesToFile(".svf.bc");
+    }
+    NapiHandler::getInstance().clearBindings();
+    NapiCallSiteIndex::getInstance().clear();
+    SVF::LLVMModuleSet::releaseLLVMModuleSet();
+}
@@ -0,0 +1,220 @@
+#include "incremental/IRHasher.h"
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/InlineAsm.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/xxhash.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+    // 常量表达式的最大展开深度，防止自引用的全局初始化无限递归
+    const int MAX_CONSTANT_DEPTH = 8;
+
+    // 把函数体序列化为与命名无关的记号串
+    class FunctionSerializer {
+    public:
+        explicit FunctionSerializer(std::string& out) : out(out) {}
+
+        void serialize(const Function& func) {
+            appendType(func.getFunctionType());
+            out += func.isVarArg() ? "|va" : "|";
+            if (func.isDeclaration()) {
+                out += "decl:" + func.getName().str();
+                return;
+            }
+
+            // 先为基本块与指令编号，再序列化，保证前向引用也能得到稳定编号
+            for (const BasicBlock& bb : func) {
+                size_t bbIndex = blockIds.size();
+                blockIds[&bb] = bbIndex;
+                for (const Instruction& inst : bb) {
+                    size_t instIndex = instIds.size();
+                    instIds[&inst] = instIndex;
+                }
+            }
+            for (const BasicBlock& bb : func) {
+                out += "\nbb";
+                for (const Instruction& inst : bb) {
+                    // 调试信息不影响分析结果
+                    if (isa<DbgInfoIntrinsic>(inst)) {
+                        continue;
+                    }
+                    appendInstruction(inst);
+                }
+            }
+        }
+
+    private:
+        std::string& out;
+        std::unordered_map<const BasicBlock*, size_t> blockIds;
+        std::unordered_map<const Instruction*, size_t> instIds;
+
+        void appendType(const Type* type) {
+            std::string text;
+            raw_string_ostream os(text);
+            type->print(os);
+            out += os.str();
+        }
+
+        void appendInstruction(const Instruction& inst) {
+            out += "\n";
+            out += inst.getOpcodeName();
+            out += " ";
+            appendType(inst.getType());
+            if (const CmpInst* cmp = dyn_cast<CmpInst>(&inst)) {
+                out += " p" + std::to_string(cmp->getPredicate());
+            } else if (const AllocaInst* alloca = dyn_cast<AllocaInst>(&inst)) {
+                out += " t";
+                appendType(alloca->getAllocatedType());
+            } else if (const GetElementPtrInst* gep = dyn_cast<GetElementPtrInst>(&inst)) {
+                out += " t";
+                appendType(gep->getSourceElementType());
+            } else if (const CallBase* call = dyn_cast<CallBase>(&inst)) {
+                out += " f";
+                appendType(call->getFunctionType());
+            }
+            for (const Use& operand : inst.operands()) {
+                out += " ";
+                appendValue(operand.get(), 0);
+            }
+        }
+
+        void appendValue(const Value* value, int depth) {
+            if (const Instruction* inst = dyn_cast<Instruction>(value)) {
+                auto it = instIds.find(inst);
+                out += it != instIds.end() ? "i" + std::to_string(it->second) : "i?";
+            } else if (const BasicBlock* bb = dyn_cast<BasicBlock>(value)) {
+                auto it = blockIds.find(bb);
+                out += it != blockIds.end() ? "b" + std::to_string(it->second) : "b?";
+            } else if (const Argument* arg = dyn_cast<Argument>(value)) {
+                out += "a" + std::to_string(arg->getArgNo());
+            } else if (const GlobalVariable* global = dyn_cast<GlobalVariable>(value)) {
+                out += "g:" + global->getName().str();
+                // 常量全局变量（如字符串字面量）的内容会进入摘要，一并计入
+                if (global->isConstant() && global->hasInitializer() && depth < MAX_CONSTANT_DEPTH) {
+                    out += "=";
+                    appendValue(global->getInitializer(), depth + 1);
+                }
+            } else if (const GlobalValue* globalValue = dyn_cast<GlobalValue>(value)) {
+                out += "g:" + globalValue->getName().str();
+            } else if (const Constant* constant = dyn_cast<Constant>(value)) {
+                appendConstant(constant, depth);
+            } else if (const InlineAsm* inlineAsm = dyn_cast<InlineAsm>(value)) {
+                out += "asm:" + inlineAsm->getAsmString();
+            } else if (isa<MetadataAsValue>(value)) {
+                out += "md";
+            } else {
+                out += "v" + std::to_string(value->getValueID());
+            }
+        }
+
+        void appendConstant(const Constant* constant, int depth) {
+            if (const ConstantInt* ci = dyn_cast<ConstantInt>(constant)) {
+                out += "ci" + std::to_string(ci->getBitWidth()) + ":" + toString(ci->getValue(), 16, true);
+            } else if (const ConstantFP* fp = dyn_cast<ConstantFP>(constant)) {
+                out += "cf:" + toString(fp->getValueAPF().bitcastToAPInt(), 16, false);
+            } else if (const ConstantDataSequential* data = dyn_cast<ConstantDataSequential>(constant)) {
+                out += "cd:";
+                out += data->getRawDataValues().str();
+            } else if (isa<ConstantPointerNull>(constant)) {
+                out += "null";
+            } else if (isa<UndefValue>(constant)) {
+                out += isa<PoisonValue>(constant) ? "poison" : "undef";
+            } else if (isa<ConstantAggregateZero>(constant)) {
+                out += "zero";
+            } else if (depth >= MAX_CONSTANT_DEPTH) {
+                out += "c...";
+            } else if (const ConstantExpr* expr = dyn_cast<ConstantExpr>(constant)) {
+                out += "ce:";
+                out += expr->getOpcodeName();
+                out += "(";
+                for (const Use& operand : expr->operands()) {
+                    appendValue(operand.get(), depth + 1);
+                    out += ",";
+                }
+                out += ")";
+            } else {
+                // 结构体、数组、向量等聚合常量
+                out += "c" + std::to_string(constant->getValueID()) + "(";
+                for (const Use& operand : constant->operands()) {
+                    appendValue(operand.get(), depth + 1);
+                    out += ",";
+                }
+                out += ")";
+            }
+            out += ":";
+            appendType(constant->getType());
+        }
+    };
+
+    std::string toHex(uint64_t value) {
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016" PRIx64, value);
+        return std::string(buffer);
+    }
+
+    // 直接调用或经指针转换后调用的函数
+    const Function* getDirectCallee(const CallBase* call) {
+        const Function* callee = call->getCalledFunction();
+        if (!callee) {
+            const Value* calleeV = call->getCalledOperand();
+            if (calleeV) {
+                callee = dyn_cast<Function>(calleeV->stripPointerCasts());
+            }
+        }
+        return callee;
+    }
+}
+
+uint64_t IRHasher::hashFunction(const Function* func) {
+    auto it = functionHashes.find(func);
+    if (it != functionHashes.end()) {
+        return it->second;
+    }
+    std::string serialized;
+    FunctionSerializer(serialized).serialize(*func);
+    uint64_t hash = xxHash64(serialized);
+    functionHashes[func] = hash;
+    return hash;
+}
+
+std::string IRHasher::hashClosure(const Function* func) {
+    // 收集调用闭包
+    std::set<const Function*> visited;
+    std::vector<const Function*> worklist = {func};
+    while (!worklist.empty()) {
+        const Function* current = worklist.back();
+        worklist.pop_back();
+        if (!visited.insert(current).second) {
+            continue;
+        }
+        for (const Instruction& inst : instructions(current)) {
+            if (const CallBase* call = dyn_cast<CallBase>(&inst)) {
+                if (const Function* callee = getDirectCallee(call)) {
+                    worklist.push_back(callee);
+                }
+            }
+        }
+    }
+
+    // 按函数名排序后组合，结果与遍历顺序无关；根函数单独标记
+    std::vector<std::pair<std::string, uint64_t>> members;
+    for (const Function* member : visited) {
+        members.emplace_back(member->getName().str(), hashFunction(member));
+    }
+    std::sort(members.begin(), members.end());
+    std::string combined = "root:" + func->getName().str() + ";";
+    for (const auto& member : members) {
+        combined += member.first + "=" + toHex(member.second) + ";";
+    }
+    return toHex(xxHash64(combined));
+}
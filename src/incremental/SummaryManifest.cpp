@@ -0,0 +1,90 @@
+#include "incremental/SummaryManifest.h"
+#include "config/EnvConfig.h"
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/xxhash.h>
+#include <fstream>
+#include <cinttypes>
+#include <cstdio>
+#include <iterator>
+
+namespace {
+    // 摘要格式变化时递增，使旧清单失效。
+    // 2：组合式摘要、调用点索引与处理函数规则调整后的摘要与此前的不可互换
+    const int MANIFEST_VERSION = 2;
+
+    // 分析程序自身的指纹：可执行文件内容的哈希，重新构建后（处理函数或传播规则可能已变化）旧清单随之失效。
+    // 读取失败时为空串，此时只依靠 MANIFEST_VERSION
+    const std::string& analyzerFingerprint() {
+        static const std::string fingerprint = []() -> std::string {
+            auto buffer = llvm::MemoryBuffer::getFile("/proc/self/exe");
+            if (!buffer) {
+                return "";
+            }
+            char hex[17];
+            std::snprintf(hex, sizeof(hex), "%016" PRIx64, llvm::xxHash64((*buffer)->getBuffer()));
+            return std::string(hex);
+        }();
+        return fingerprint;
+    }
+}
+
+SummaryManifest::SummaryManifest(const std::string& path)
+    : path(path), previous(nlohmann::json::object()), current(nlohmann::json::object()) {
+}
+
+bool SummaryManifest::isEnabled() {
+    return EnvConfig::getBool("NAPI_SVF_INCREMENTAL", true);
+}
+
+bool SummaryManifest::load() {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    nlohmann::json manifest = nlohmann::json::parse(content, nullptr, false);
+    if (manifest.is_discarded() || !manifest.is_object() || manifest.value("version", 0) != MANIFEST_VERSION ||
+        manifest.value("analyzer", std::string()) != analyzerFingerprint()) {
+        return false;
+    }
+    auto functions = manifest.find("functions");
+    if (functions == manifest.end() || !functions->is_object()) {
+        return false;
+    }
+    previous = *functions;
+    return true;
+}
+
+const nlohmann::json* SummaryManifest::lookup(const std::string& funcName, const std::string& hash) const {
+    auto entry = previous.find(funcName);
+    if (entry == previous.end() || !entry->is_object()) {
+        return nullptr;
+    }
+    auto storedHash = entry->find("hash");
+    auto summary = entry->find("summary");
+    if (storedHash == entry->end() || summary == entry->end() || *storedHash != hash) {
+        return nullptr;
+    }
+    return &(*summary);
+}
+
+void SummaryManifest::record(const std::string& funcName, const std::string& hash, const nlohmann::json& summary) {
+    current[funcName] = {{"hash", hash}, {"summary", summary}};
+}
+
+bool SummaryManifest::save() const {
+    nlohmann::json manifest;
+    manifest["version"] = MANIFEST_VERSION;
+    manifest["analyzer"] = analyzerFingerprint();
+    manifest["functions"] = current;
+
+    // 先写临时文件再改名，避免进程被中途终止时留下半个清单
+    std::string tempPath = path + ".tmp";
+    std::ofstream file(tempPath);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << manifest.dump();
+    file.close();
+    return std::rename(tempPath.c_str(), path.c_str()) == 0;
+}
@@ -0,0 +1,237 @@
+#include "metrics/Metrics.h"
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+
+namespace {
+    // 汇总中每个库保留的最慢函数数量，完整的函数记录见各库的 .timing.json
+    const size_t SLOWEST_FUNCTIONS_PER_LIBRARY = 10;
+
+    double toSeconds(const struct timeval& tv) {
+        return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+    }
+
+    double percentile(const std::vector<double>& sorted, double p) {
+        // 最近秩法：第 ceil(p * n) 个值
+        size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+        return sorted[rank == 0 ? 0 : rank - 1];
+    }
+
+    double numberOr(const nlohmann::json& json, const char* key, double fallback) {
+        auto it = json.find(key);
+        return (it != json.end() && it->is_number()) ? it->get<double>() : fallback;
+    }
+}
+
+MetricCounters& MetricCounters::operator+=(const MetricCounters& other) {
+    handlerInvocations += other.handlerInvocations;
+    svfgNodesVisited += other.svfgNodesVisited;
+    aliasQueries += other.aliasQueries;
+    slicesComputed += other.slicesComputed;
+    sliceCacheHits += other.sliceCacheHits;
+    slicesTruncated += other.slicesTruncated;
+    return *this;
+}
+
+MetricCounters MetricCounters::operator-(const MetricCounters& other) const {
+    MetricCounters diff;
+    diff.handlerInvocations = handlerInvocations - other.handlerInvocations;
+    diff.svfgNodesVisited = svfgNodesVisited - other.svfgNodesVisited;
+    diff.aliasQueries = aliasQueries - other.aliasQueries;
+    diff.slicesComputed = slicesComputed - other.slicesComputed;
+    diff.sliceCacheHits = sliceCacheHits - other.sliceCacheHits;
+    diff.slicesTruncated = slicesTruncated - other.slicesTruncated;
+    return diff;
+}
+
+MetricCounters& Metrics::local() {
+    thread_local MetricCounters counters;
+    return counters;
+}
+
+double Metrics::threadCpuSeconds() {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0.0;
+    }
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+double Metrics::processCpuSeconds() {
+    double seconds = 0.0;
+    struct rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        seconds += toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+    }
+    // fork 模式下函数分析在子进程中进行，其CPU时间在回收后计入 RUSAGE_CHILDREN
+    if (getrusage(RUSAGE_CHILDREN, &usage) == 0) {
+        seconds += toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+    }
+    return seconds;
+}
+
+long Metrics::peakRssKb() {
+    struct rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return usage.ru_maxrss;
+}
+
+long Metrics::currentRssKb() {
+    std::ifstream statm("/proc/self/statm");
+    long totalPages = 0;
+    long residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) {
+        return 0;
+    }
+    return residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+nlohmann::json Metrics::countersToJson(const MetricCounters& counters) {
+    return {
+        {"handler_invocations", counters.handlerInvocations},
+        {"svfg_nodes_visited", counters.svfgNodesVisited},
+        {"alias_queries", counters.aliasQueries},
+        {"slices_computed", counters.slicesComputed},
+        {"slice_cache_hits", counters.sliceCacheHits},
+        {"slices_truncated", counters.slicesTruncated}
+    };
+}
+
+MetricCounters Metrics::countersFromJson(const nlohmann::json& json) {
+    MetricCounters counters;
+    counters.handlerInvocations = static_cast<uint64_t>(numberOr(json, "handler_invocations", 0));
+    counters.svfgNodesVisited = static_cast<uint64_t>(numberOr(json, "svfg_nodes_visited", 0));
+    counters.aliasQueries = static_cast<uint64_t>(numberOr(json, "alias_queries", 0));
+    counters.slicesComputed = static_cast<uint64_t>(numberOr(json, "slices_computed", 0));
+    counters.sliceCacheHits = static_cast<uint64_t>(numberOr(json, "slice_cache_hits", 0));
+    counters.slicesTruncated = static_cast<uint64_t>(numberOr(json, "slices_truncated", 0));
+    return counters;
+}
+
+nlohmann::json Metrics::distribution(std::vector<double> values) {
+    nlohmann::json result;
+    result["count"] = values.size();
+    if (values.empty()) {
+        return result;
+    }
+    std::sort(values.begin(), values.end());
+    double total = 0.0;
+    for (double value : values) {
+        total += value;
+    }
+    result["total"] = total;
+    result["p50"] = percentile(values, 0.50);
+    result["p90"] = percentile(values, 0.90);
+    result["p99"] = percentile(values, 0.99);
+    result["max"] = values.back();
+    return result;
+}
+
+nlohmann::json Metrics::summarize(const std::vector<nlohmann::json>& libraryRecords) {
+    // 库级与函数级分别统计的字段
+    static const char* const LIBRARY_FIELDS[] = {
+        "wall_time_seconds", "cpu_time_seconds", "peak_rss_mb",
+        "svf_construction_time_seconds", "property_analysis_time_seconds", "taint_analysis_time_seconds",
+        "vfg_construction_time_seconds", "vfg_rss_delta_mb",
+        "handler_invocations", "svfg_nodes_visited", "alias_queries",
+        "slices_computed", "slice_cache_hits", "slices_truncated"
+    };
+    static const char* const FUNCTION_FIELDS[] = {
+        "wall_time_seconds", "cpu_time_seconds",
+        "handler_invocations", "svfg_nodes_visited", "alias_queries",
+        "slices_computed", "slice_cache_hits", "slices_truncated"
+    };
+
+    std::map<std::string, std::vector<double>> libraryValues;
+    std::map<std::string, std::vector<double>> functionValues;
+    nlohmann::json libraries = nlohmann::json::array();
+    MetricCounters totals;
+    size_t timedOut = 0;
+    nlohmann::json librariesByTier = nlohmann::json::object();
+
+    for (const nlohmann::json& record : libraryRecords) {
+        if (!record.is_object()) {
+            continue;
+        }
+        for (const char* field : LIBRARY_FIELDS) {
+            if (record.contains(field) && record[field].is_number()) {
+                libraryValues[field].push_back(record[field].get<double>());
+            }
+        }
+        totals += countersFromJson(record);
+        if (record.value("timed_out", false)) {
+            timedOut++;
+        }
+        if (record.contains("analysis_tier") && record["analysis_tier"].is_string()) {
+            const std::string tier = record["analysis_tier"].get<std::string>();
+            librariesByTier[tier] = librariesByTier.value(tier, 0) + 1;
+        }
+
+        // 汇总中只保留每个库最慢的几个函数
+        nlohmann::json summary = record;
+        summary.erase("functions");
+        std::vector<const nlohmann::json*> functions;
+        if (record.contains("functions") && record["functions"].is_array()) {
+            for (const nlohmann::json& function : record["functions"]) {
+                for (const char* field : FUNCTION_FIELDS) {
+                    if (function.contains(field) && function[field].is_number()) {
+                        functionValues[field].push_back(function[field].get<double>());
+                    }
+                }
+                functions.push_back(&function);
+            }
+        }
+        std::sort(functions.begin(), functions.end(), [](const nlohmann::json* a, const nlohmann::json* b) {
+            return numberOr(*a, "wall_time_seconds", 0.0) > numberOr(*b, "wall_time_seconds", 0.0);
+        });
+        nlohmann::json slowest = nlohmann::json::array();
+        for (size_t i = 0; i < functions.size() && i < SLOWEST_FUNCTIONS_PER_LIBRARY; i++) {
+            slowest.push_back(*functions[i]);
+        }
+        summary["function_count"] = functions.size();
+        summary["slowest_functions"] = slowest;
+        libraries.push_back(summary);
+    }
+
+    nlohmann::json libraryDistribution = nlohmann::json::object();
+    for (const char* field : LIBRARY_FIELDS) {
+        libraryDistribution[field] = distribution(libraryValues[field]);
+    }
+    nlohmann::json functionDistribution = nlohmann::json::object();
+    for (const char* field : FUNCTION_FIELDS) {
+        functionDistribution[field] = distribution(functionValues[field]);
+    }
+
+    nlohmann::json result;
+    result["totals"] = countersToJson(totals);
+    result["totals"]["libraries_reported"] = libraryRecords.size();
+    result["totals"]["libraries_timed_out"] = timedOut;
+    result["totals"]["libraries_by_tier"] = librariesByTier;
+    result["library_distribution"] = libraryDistribution;
+    result["function_distribution"] = functionDistribution;
+    result["libraries"] = libraries;
+    return result;
+}
+
+MetricsProbe::MetricsProbe(bool processWide)
+    : processWide(processWide), startTime(std::chrono::steady_clock::now()),
+      startCpu(processWide ? Metrics::processCpuSeconds() : Metrics::threadCpuSeconds()),
+      startCounters(Metrics::local()) {
+}
+
+nlohmann::json MetricsProbe::finish(const std::string& name) const {
+    double cpu = (processWide ? Metrics::processCpuSeconds() : Metrics::threadCpuSeconds()) - startCpu;
+    nlohmann::json record = Metrics::countersToJson(counters());
+    record["name"] = name;
+    record["wall_time_seconds"] = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    record["cpu_time_seconds"] = cpu;
+    // 峰值RSS是进程级的：多线程模式下同一库的函数共享同一个值
+    record["peak_rss_mb"] = static_cast<double>(Metrics::peakRssKb()) / 1024.0;
+    return record;
+}
@@ -1,54 +1,37 @@
 #include "napi/AnalyzeProperties.h"
+#include "napi/NapiCallSiteIndex.h"
 
 using namespace llvm;
 using namespace SVF;
 
-std::set<GlobalVariable*> NapiPropertiesAnalyzer::analyzeNapiProperties(SVFG* svfg,SVFIR* pag) {
+std::set<GlobalVariable*> NapiPropertiesAnalyzer::analyzeNapiProperties(SVFG* svfg, SVFIR* pag, PointerAnalysis* pta) {
     std::set<GlobalVariable*> globalVars;
-   
-    // 创建指针分析
-    Andersen* ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
 
-    // 获取调用图
-    CallGraph* callGraph = ander->getCallGraph();
-
-    Module* llvmModule = LLVMModuleSet::getLLVMModuleSet()->getMainLLVMModule();
+    const NapiCallSiteIndex& callSiteIndex = NapiCallSiteIndex::getInstance();
     
     // 存储napi_module_register调用与对应的模块结构体指针
     std::map<GlobalVariable*, const Function*> moduleToInitFunc;
 
     // 第一步：找到所有napi_module_register调用及其参数
-    for(Function &F : *llvmModule){
-        for(BasicBlock &BB : F){
-            for(Instruction &I : BB){
-                if (const CallBase* callInst = SVFUtil::dyn_cast<CallBase>(&I)){
-                    const Function* calledFunc = callInst->getCalledFunction();
-                    if (!calledFunc || calledFunc->isIntrinsic())
-                        continue;
-                    
-                    if (calledFunc->getName() == "napi_module_register"){
-                        SVFUtil::outs() << "Found napi_module_register call in: " << F.getName().str() << "\n";
-                        
-                        // 获取传递给napi_module_register的参数（napi_module结构体指针）
-                        if (callInst->arg_size() > 0) {
-                            Value* moduleArg = callInst->getArgOperand(0);
-                            
-                            // 获取全局变量
-                            if (GlobalVariable* moduleGlobal = SVFUtil::dyn_cast<GlobalVariable>(moduleArg)) {
-                                SVFUtil::outs() << "  Module global: " << moduleGlobal->getName().str() << "\n";
-                                
-                                // 解析napi_module结构体
-                                if (ConstantStruct* moduleStruct = SVFUtil::dyn_cast<ConstantStruct>(moduleGlobal->getInitializer())) {
-                                    // napi_module的第4个字段是注册函数（nm_register_func）
-                                    if (moduleStruct->getNumOperands() >= 4) {
-                                        Value* regFuncVal = moduleStruct->getOperand(3)->stripPointerCasts();
-                                        if (const Function* regFunc = SVFUtil::dyn_cast<Function>(regFuncVal)) {
-                                            SVFUtil::outs() << "  Found register function: " << regFunc->getName().str() << "\n";
-                                            moduleToInitFunc[moduleGlobal] = regFunc;
-                                        }
-                                    }
-                                }
-                            }
+    for (const CallBase* callInst : callSiteIndex.callSitesOf("napi_module_register")) {
+        SVFUtil::outs() << "Found napi_module_register call in: " << callInst->getFunction()->getName().str() << "\n";
+        
+        // 获取传递给napi_module_register的参数（napi_module结构体指针）
+        if (callInst->arg_size() > 0) {
+            Value* moduleArg = callInst->getArgOperand(0);
+            
+            // 获取全局变量
+            if (GlobalVariable* moduleGlobal = SVFUtil::dyn_cast<GlobalVariable>(moduleArg)) {
+                SVFUtil::outs() << "  Module global: " << moduleGlobal->getName().str() << "\n";
+                
+                // 解析napi_module结构体
+                if (ConstantStruct* moduleStruct = SVFUtil::dyn_cast<ConstantStruct>(moduleGlobal->getInitializer())) {
+                    // napi_module的第4个字段是注册函数（nm_register_func）
+                    if (moduleStruct->getNumOperands() >= 4) {
+                        Value* regFuncVal = moduleStruct->getOperand(3)->stripPointerCasts();
+                        if (const Function* regFunc = SVFUtil::dyn_cast<Function>(regFuncVal)) {
+                            SVFUtil::outs() << "  Found register function: " << regFunc->getName().str() << "\n";
+                            moduleToInitFunc[moduleGlobal] = regFunc;
                         }
                     }
                 }
@@ -61,60 +44,50 @@ std::set<GlobalVariable*> NapiPropertiesAnalyzer::analyzeNapiProperties(SVFG* sv
         const Function* initFunc = pair.second;
         
         // 分析初始化函数中的napi_define_properties调用
-        for (auto &BB : *initFunc) {
-            for (auto &I : BB) {
-                if (const CallBase* callInst = SVFUtil::dyn_cast<CallBase>(&I)) {
-                    const Function* calledFunc = callInst->getCalledFunction();
-                    if (!calledFunc || calledFunc->isIntrinsic())
-                        continue;
-                    
-                    if (calledFunc->getName() == "napi_define_properties"){
-                        SVFUtil::outs() << "Found napi_define_properties in init function: " << initFunc->getName().str() << "\n";
-                        
-                        // 获取源代码位置信息
-                        const DebugLoc& loc = callInst->getDebugLoc();
+        for (const CallBase* callInst : callSiteIndex.callSitesOf("napi_define_properties", initFunc)) {
+            SVFUtil::outs() << "Found napi_define_properties in init function: " << initFunc->getName().str() << "\n";
+            
+            // 获取源代码位置信息
+            const DebugLoc& loc = callInst->getDebugLoc();
 
-                        // 解析参数（根据函数签名）
-                        // 参数顺序：env, exports, property_count, properties
-                        Value* envArg = callInst->getArgOperand(0);
-                        Value* exportsArg = callInst->getArgOperand(1);
-                        Value* propCountArg = callInst->getArgOperand(2);
-                        Value* propArrayArg = callInst->getArgOperand(3);
+            // 解析参数（根据函数签名）
+            // 参数顺序：env, exports, property_count, properties
+            Value* envArg = callInst->getArgOperand(0);
+            Value* exportsArg = callInst->getArgOperand(1);
+            Value* propCountArg = callInst->getArgOperand(2);
+            Value* propArrayArg = callInst->getArgOperand(3);
 
-                        // 分析属性数组
-                        if (ConstantInt* count = SVFUtil::dyn_cast<ConstantInt>(propCountArg)) {
-                            uint64_t arraySize = count->getZExtValue();
-                            SVFUtil::outs() << "  Property count: " << arraySize << "\n";
+            // 分析属性数组
+            if (ConstantInt* count = SVFUtil::dyn_cast<ConstantInt>(propCountArg)) {
+                uint64_t arraySize = count->getZExtValue();
+                SVFUtil::outs() << "  Property count: " << arraySize << "\n";
 
-                            if (GetElementPtrInst* gep = SVFUtil::dyn_cast<GetElementPtrInst>(propArrayArg)) {
-                                if (AllocaInst* alloca = SVFUtil::dyn_cast<AllocaInst>(gep->getPointerOperand())) {
-                                    // 搜索该alloca的所有使用者，找到memcpy指令
-                                    for (User* user : alloca->users()) {
-                                        if (MemCpyInst* memcpy = SVFUtil::dyn_cast<MemCpyInst>(user)) {
-                                            if (Constant* src = SVFUtil::dyn_cast<Constant>(memcpy->getSource())) {
-                                                // 剥离可能的bitcast操作
-                                                if (GlobalVariable* global = SVFUtil::dyn_cast<GlobalVariable>(src->stripPointerCasts())) {
-                                                    SVFUtil::outs() << "Found target global: " << global->getName().str() << "\n";
-                                                    globalVars.insert(global);
-                                                }
-                                            }
-                                        }
+                if (GetElementPtrInst* gep = SVFUtil::dyn_cast<GetElementPtrInst>(propArrayArg)) {
+                    if (AllocaInst* alloca = SVFUtil::dyn_cast<AllocaInst>(gep->getPointerOperand())) {
+                        // 搜索该alloca的所有使用者，找到memcpy指令
+                        for (User* user : alloca->users()) {
+                            if (MemCpyInst* memcpy = SVFUtil::dyn_cast<MemCpyInst>(user)) {
+                                if (Constant* src = SVFUtil::dyn_cast<Constant>(memcpy->getSource())) {
+                                    // 剥离可能的bitcast操作
+                                    if (GlobalVariable* global = SVFUtil::dyn_cast<GlobalVariable>(src->stripPointerCasts())) {
+                                        SVFUtil::outs() << "Found target global: " << global->getName().str() << "\n";
+                                        globalVars.insert(global);
                                     }
                                 }
                             }
-                            else{
-                                if (AllocaInst* alloca = SVFUtil::dyn_cast<AllocaInst>(propArrayArg)) {
-                                    // 搜索该alloca的所有使用者，找到memcpy指令
-                                    for (User* user : alloca->users()) {
-                                        if (MemCpyInst* memcpy = SVFUtil::dyn_cast<MemCpyInst>(user)) {
-                                            if (Constant* src = SVFUtil::dyn_cast<Constant>(memcpy->getSource())) {
-                                                // 剥离可能的bitcast操作
-                                                if (GlobalVariable* global = SVFUtil::dyn_cast<GlobalVariable>(src->stripPointerCasts())) {
-                                                    SVFUtil::outs() << "Found target global: " << global->getName().str() << "\n";
-                                                    globalVars.insert(global);
-                                                }
-                                            }
-                                        }
+                        }
+                    }
+                }
+                else{
+                    if (AllocaInst* alloca = SVFUtil::dyn_cast<AllocaInst>(propArrayArg)) {
+                        // 搜索该alloca的所有使用者，找到memcpy指令
+                        for (User* user : alloca->users()) {
+                            if (MemCpyInst* memcpy = SVFUtil::dyn_cast<MemCpyInst>(user)) {
+                                if (Constant* src = SVFUtil::dyn_cast<Constant>(memcpy->getSource())) {
+                                    // 剥离可能的bitcast操作
+                                    if (GlobalVariable* global = SVFUtil::dyn_cast<GlobalVariable>(src->stripPointerCasts())) {
+                                        SVFUtil::outs() << "Found target global: " << global->getName().str() << "\n";
+                                        globalVars.insert(global);
                                     }
                                 }
                             }
@@ -162,36 +135,24 @@ std::map<std::string, Function*> NapiPropertiesAnalyzer::analyzeGlobalVars(std::
 }
 
 // 查找模块注册函数
-std::map<GlobalVariable*, const Function*> NapiPropertiesAnalyzer::findModuleInitFunctions(Module* llvmModule) {
+std::map<GlobalVariable*, const Function*> NapiPropertiesAnalyzer::findModuleInitFunctions() {
     std::map<GlobalVariable*, const Function*> moduleToInitFunc;
     
     // 查找所有napi_module_register调用及其参数
-    for(Function &F : *llvmModule){
-        for(BasicBlock &BB : F){
-            for(Instruction &I : BB){
-                if (const CallBase* callInst = SVFUtil::dyn_cast<CallBase>(&I)){
-                    const Function* calledFunc = callInst->getCalledFunction();
-                    if (!calledFunc || calledFunc->isIntrinsic())
-                        continue;
-                    
-                    if (calledFunc->getName() == "napi_module_register"){
-                        // 获取传递给napi_module_register的参数（napi_module结构体指针）
-                        if (callInst->arg_size() > 0) {
-                            Value* moduleArg = callInst->getArgOperand(0);
-                            
-                            // 获取全局变量
-                            if (GlobalVariable* moduleGlobal = SVFUtil::dyn_cast<GlobalVariable>(moduleArg)) {
-                                // 解析napi_module结构体
-                                if (ConstantStruct* moduleStruct = SVFUtil::dyn_cast<ConstantStruct>(moduleGlobal->getInitializer())) {
-                                    // napi_module的第4个字段是注册函数（nm_register_func）
-                                    if (moduleStruct->getNumOperands() >= 4) {
-                                        Value* regFuncVal = moduleStruct->getOperand(3)->stripPointerCasts();
-                                        if (const Function* regFunc = SVFUtil::dyn_cast<Function>(regFuncVal)) {
-                                            moduleToInitFunc[moduleGlobal] = regFunc;
-                                        }
-                                    }
-                                }
-                            }
+    for (const CallBase* callInst : NapiCallSiteIndex::getInstance().callSitesOf("napi_module_register")) {
+        // 获取传递给napi_module_register的参数（napi_module结构体指针）
+        if (callInst->arg_size() > 0) {
+            Value* moduleArg = callInst->getArgOperand(0);
+            
+            // 获取全局变量
+            if (GlobalVariable* moduleGlobal = SVFUtil::dyn_cast<GlobalVariable>(moduleArg)) {
+                // 解析napi_module结构体
+                if (ConstantStruct* moduleStruct = SVFUtil::dyn_cast<ConstantStruct>(moduleGlobal->getInitializer())) {
+                    // napi_module的第4个字段是注册函数（nm_register_func）
+                    if (moduleStruct->getNumOperands() >= 4) {
+                        Value* regFuncVal = moduleStruct->getOperand(3)->stripPointerCasts();
+                        if (const Function* regFunc = SVFUtil::dyn_cast<Function>(regFuncVal)) {
+                            moduleToInitFunc[moduleGlobal] = regFunc;
                         }
                     }
                 }
@@ -203,7 +164,6 @@ std::map<GlobalVariable*, const Function*> NapiPropertiesAnalyzer::findModuleIni
 }
 
 
-
 // 查找属性值与napi_create_function结果指针之间的关系
 Function* NapiPropertiesAnalyzer::findCallbackForValue(
     Value* valueVal, 
@@ -213,49 +173,36 @@ Function* NapiPropertiesAnalyzer::findCallbackForValue(
     PointerAnalysis* pta,
     SVFG* svfg) {
     
-    for (auto &BB : *initFunc) {
-        for (auto &I : BB) {
-            // 使用LLVMUtil检查是否是函数调用
-            if (LLVMUtil::isCallSite(&I)) {
-                const CallBase* createFuncCall = LLVMUtil::getLLVMCallSite(&I);
-                const Function* calledFunction = LLVMUtil::getCallee(createFuncCall);
+    // 只需查看初始化函数中对napi_create_function的调用
+    for (const CallBase* createFuncCall : NapiCallSiteIndex::getInstance().callSitesOf("napi_create_function", initFunc)) {
+        SVFUtil::outs() << "Found napi_create_function call\n";
+        
+        // 参数顺序：env, name, length, cb, data, result
+        if (createFuncCall->arg_size() >= 6) {
+            // 获取回调函数（第4个参数）
+            Value* cbFunc = createFuncCall->getArgOperand(3);
+            // 获取结果函数指针（第6个参数）
+            Value* resultPtr = createFuncCall->getArgOperand(5);
+            
+            if (Function* callback = SVFUtil::dyn_cast<Function>(cbFunc->stripPointerCasts())) {
+                // 使用指针分析检查valueVal是否指向resultPtr
+                NodeID resultNodeId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(resultPtr);
                 
-                if (!calledFunction)
-                    continue;
+                // 使用checkPotentialAlias检查valueVal和resultPtr是否可能是别名
+                if (checkPotentialAlias(valueNodeId, resultNodeId, svfg)) {
+                    SVFUtil::outs() << "  Found callback through potential alias check between valueVal and resultPtr\n";
+                    return callback;
+                }
                 
-                // 检查是否是napi_create_function调用
-                if (calledFunction->getName().str() == "napi_create_function") {
-                    SVFUtil::outs() << "Found napi_create_function call\n";
+                // 如果是加载指令，检查加载源
+                if (LoadInst* loadInst = SVFUtil::dyn_cast<LoadInst>(valueVal)) {
+                    Value* loadSrc = loadInst->getPointerOperand();
+                    NodeID loadSrcId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(loadSrc);
                     
-                    // 参数顺序：env, name, length, cb, data, result
-                    if (createFuncCall->arg_size() >= 6) {
-                        // 获取回调函数（第4个参数）
-                        Value* cbFunc = createFuncCall->getArgOperand(3);
-                        // 获取结果函数指针（第6个参数）
-                        Value* resultPtr = createFuncCall->getArgOperand(5);
-                        
-                        if (Function* callback = SVFUtil::dyn_cast<Function>(cbFunc->stripPointerCasts())) {
-                            // 使用指针分析检查valueVal是否指向resultPtr
-                            NodeID resultNodeId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(resultPtr);
-                            
-                            // 使用checkPotentialAlias检查valueVal和resultPtr是否可能是别名
-                            if (checkPotentialAlias(valueNodeId, resultNodeId, svfg)) {
-                                SVFUtil::outs() << "  Found callback through potential alias check between valueVal and resultPtr\n";
-                                return callback;
-                            }
-                            
-                            // 如果是加载指令，检查加载源
-                            if (LoadInst* loadInst = SVFUtil::dyn_cast<LoadInst>(valueVal)) {
-                                Value* loadSrc = loadInst->getPointerOperand();
-                                NodeID loadSrcId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(loadSrc);
-                                
-                                // 使用checkPotentialAlias检查loadSrc和resultPtr是否可能是别名
-                                if (checkPotentialAlias(loadSrcId, resultNodeId, svfg)) {
-                                    SVFUtil::outs() << "  Found callback through potential alias check between loadSrc and resultPtr\n";
-                                    return callback;
-                                }
-                            }
-                        }
+                    // 使用checkPotentialAlias检查loadSrc和resultPtr是否可能是别名
+                    if (checkPotentialAlias(loadSrcId, resultNodeId, svfg)) {
+                        SVFUtil::outs() << "  Found callback through potential alias check between loadSrc and resultPtr\n";
+                        return callback;
                     }
                 }
             }
@@ -267,7 +214,6 @@ Function* NapiPropertiesAnalyzer::findCallbackForValue(
 
 // 分析napi_set_named_property调用与初始化函数返回值的关系
 void NapiPropertiesAnalyzer::analyzeSetNamedPropertyCalls(
-    Module* llvmModule, 
     const Function* initFunc, 
     NodeID retNodeId,
     SVFIR* pag, 
@@ -276,59 +222,47 @@ void NapiPropertiesAnalyzer::analyzeSetNamedPropertyCalls(
     std::map<std::string, Function*>& functions) {
     
     // 查找所有napi_set_named_property调用
-    for (Function &F : *llvmModule) {
-        for (BasicBlock &BB : F) {
-            for (Instruction &I : BB) {
-                if (const CallBase* callInst = SVFUtil::dyn_cast<CallBase>(&I)) {
-                    const Function* calledFunc = callInst->getCalledFunction();
-                    if (!calledFunc || calledFunc->isIntrinsic())
-                        continue;
-                    
-                    if (calledFunc->getName() == "napi_set_named_property") {
-                        SVFUtil::outs() << "Found napi_set_named_property call in: " << F.getName().str() << "\n";
-                        
-                        // 参数顺序：env, object, name, value
-                        if (callInst->arg_size() >= 4) {
-                            // 获取对象参数（第2个参数）
-                            Value* objVal = callInst->getArgOperand(1);
-                            NodeID objNodeId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(objVal);
-                            
-                            // 获取属性名（第3个参数）
-                            Value* nameVal = callInst->getArgOperand(2);
-                            
-                            // 获取属性值（第4个参数）
-                            Value* valueVal = callInst->getArgOperand(3);
-                            NodeID valueNodeId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(valueVal);
-                            
-                            // 解析属性名
-                            std::string propNameStr;
-                            if (GlobalVariable* nameGlobal = SVFUtil::dyn_cast<GlobalVariable>(nameVal->stripPointerCasts())) {
-                                if (ConstantDataArray* nameArray = SVFUtil::dyn_cast<ConstantDataArray>(nameGlobal->getInitializer())) {
-                                    StringRef propName = nameArray->getAsCString();
-                                    propNameStr = propName.str();
-                                    SVFUtil::outs() << "  Property name: " << propNameStr << "\n";
-                                }
-                            }
-                            
-                            // 直接使用NodeID检查对象是否可能是初始化函数的返回值
-                            bool isReturnValue = checkPotentialAlias(objNodeId, retNodeId, svfg);
-                            if (isReturnValue) {
-                                SVFUtil::outs() << "  Object is potentially an alias of init function return value\n";
-                            }
+    for (const CallBase* callInst : NapiCallSiteIndex::getInstance().callSitesOf("napi_set_named_property")) {
+        SVFUtil::outs() << "Found napi_set_named_property call in: " << callInst->getFunction()->getName().str() << "\n";
+        
+        // 参数顺序：env, object, name, value
+        if (callInst->arg_size() >= 4) {
+            // 获取对象参数（第2个参数）
+            Value* objVal = callInst->getArgOperand(1);
+            NodeID objNodeId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(objVal);
+            
+            // 获取属性名（第3个参数）
+            Value* nameVal = callInst->getArgOperand(2);
+            
+            // 获取属性值（第4个参数）
+            Value* valueVal = callInst->getArgOperand(3);
+            NodeID valueNodeId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(valueVal);
+            
+            // 解析属性名
+            std::string propNameStr;
+            if (GlobalVariable* nameGlobal = SVFUtil::dyn_cast<GlobalVariable>(nameVal->stripPointerCasts())) {
+                if (ConstantDataArray* nameArray = SVFUtil::dyn_cast<ConstantDataArray>(nameGlobal->getInitializer())) {
+                    StringRef propName = nameArray->getAsCString();
+                    propNameStr = propName.str();
+                    SVFUtil::outs() << "  Property name: " << propNameStr << "\n";
+                }
+            }
+            
+            // 直接使用NodeID检查对象是否可能是初始化函数的返回值
+            bool isReturnValue = checkPotentialAlias(objNodeId, retNodeId, svfg);
+            if (isReturnValue) {
+                SVFUtil::outs() << "  Object is potentially an alias of init function return value\n";
+            }
 
-                            if (isReturnValue && !propNameStr.empty()) {
-                                SVFUtil::outs() << "  Processing property: " << propNameStr << " for export object\n";
-                                
-                                // 查找属性值与napi_create_function结果指针之间的关系
-                                Function* callback = findCallbackForValue(valueVal, valueNodeId, initFunc, pag, pta, svfg);
-                                
-                                if (callback) {
-                                    SVFUtil::outs() << "  Found callback for property: " << propNameStr << "\n";
-                                    functions[propNameStr] = callback;
-                                }
-                            }
-                        }
-                    }
+            if (isReturnValue && !propNameStr.empty()) {
+                SVFUtil::outs() << "  Processing property: " << propNameStr << " for export object\n";
+                
+                // 查找属性值与napi_create_function结果指针之间的关系
+                Function* callback = findCallbackForValue(valueVal, valueNodeId, initFunc, pag, pta, svfg);
+                
+                if (callback) {
+                    SVFUtil::outs() << "  Found callback for property: " << propNameStr << "\n";
+                    functions[propNameStr] = callback;
                 }
             }
         }
@@ -339,11 +273,8 @@ void NapiPropertiesAnalyzer::analyzeSetNamedPropertyCalls(
 std::map<std::string, Function*> NapiPropertiesAnalyzer::analyzeNamedProperties(SVFG* svfg, SVFIR* pag, PointerAnalysis* pta) {
     std::map<std::string, Function*> functions;
     
-    // 获取LLVM模块
-    Module* llvmModule = LLVMModuleSet::getLLVMModuleSet()->getMainLLVMModule();
-    
     // 第一步：找到所有napi_module_register调用及其参数
-    std::map<GlobalVariable*, const Function*> moduleToInitFunc = findModuleInitFunctions(llvmModule);
+    std::map<GlobalVariable*, const Function*> moduleToInitFunc = findModuleInitFunctions();
     
     // 第二步：分析初始化函数的返回值及其与napi_set_named_property的关系
     for (auto &pair : moduleToInitFunc) {
@@ -370,7 +301,7 @@ std::map<std::string, Function*> NapiPropertiesAnalyzer::analyzeNamedProperties(
         }
 
         // 分析napi_set_named_property调用与初始化函数返回值的关系
-        analyzeSetNamedPropertyCalls(llvmModule, initFunc, retNodeId, pag, pta, svfg, functions);
+        analyzeSetNamedPropertyCalls(initFunc, retNodeId, pag, pta, svfg, functions);
     }
     
     return functions;
@@ -0,0 +1,87 @@
+#include "napi/NapiCallSiteIndex.h"
+#include "SVF-LLVM/LLVMModule.h"
+#include <llvm/IR/InstIterator.h>
+
+using namespace SVF;
+
+NapiCallSiteIndex& NapiCallSiteIndex::getInstance() {
+    static NapiCallSiteIndex instance;
+    return instance;
+}
+
+const llvm::Function* NapiCallSiteIndex::resolveCallee(const llvm::CallBase* callSite) {
+    const llvm::Function* callee = callSite->getCalledFunction();
+    if (!callee) {
+        const llvm::Value* calleeV = callSite->getCalledOperand();
+        if (calleeV) {
+            callee = llvm::dyn_cast<llvm::Function>(calleeV->stripPointerCasts());
+        }
+    }
+    return callee;
+}
+
+void NapiCallSiteIndex::build() {
+    clear();
+    // 先按被调函数指针分组，最后每个外部函数只取一次名字
+    llvm::DenseMap<const llvm::Function*, std::vector<const llvm::CallBase*>> byCalleeFunction;
+    std::vector<const llvm::Function*> calleeOrder;
+    for (const llvm::Module& module : LLVMModuleSet::getLLVMModuleSet()->getLLVMModules()) {
+        for (const llvm::Function& function : module) {
+            if (function.isDeclaration()) {
+                continue;
+            }
+            std::vector<const llvm::CallBase*>& inCaller = callSitesByCaller[&function];
+            for (const llvm::Instruction& inst : llvm::instructions(function)) {
+                const llvm::CallBase* callSite = llvm::dyn_cast<llvm::CallBase>(&inst);
+                if (!callSite) {
+                    continue;
+                }
+                const llvm::Function* callee = resolveCallee(callSite);
+                if (!callee) {
+                    continue;
+                }
+                inCaller.push_back(callSite);
+                if (callee->isDeclaration() && !callee->isIntrinsic()) {
+                    auto inserted = byCalleeFunction.try_emplace(callee);
+                    if (inserted.second) {
+                        calleeOrder.push_back(callee);
+                    }
+                    inserted.first->second.push_back(callSite);
+                }
+            }
+        }
+    }
+    for (const llvm::Function* callee : calleeOrder) {
+        std::vector<const llvm::CallBase*>& sites = callSitesByCallee[callee->getName().str()];
+        const std::vector<const llvm::CallBase*>& found = byCalleeFunction[callee];
+        sites.insert(sites.end(), found.begin(), found.end());
+    }
+}
+
+void NapiCallSiteIndex::clear() {
+    callSitesByCallee.clear();
+    callSitesByCaller.clear();
+}
+
+const std::vector<const llvm::CallBase*>& NapiCallSiteIndex::callSitesOf(const std::string& calleeName) const {
+    static const std::vector<const llvm::CallBase*> empty;
+    auto it = callSitesByCallee.find(calleeName);
+    return it == callSitesByCallee.end() ? empty : it->second;
+}
+
+std::vector<const llvm::CallBase*> NapiCallSiteIndex::callSitesOf(const std::string& calleeName,
+                                                                 const llvm::Function* caller) const {
+    std::vector<const llvm::CallBase*> result;
+    for (const llvm::CallBase* callSite : callSitesOf(calleeName)) {
+        if (callSite->getFunction() == caller) {
+            result.push_back(callSite);
+        }
+    }
+    return result;
+}
+
+const std::vector<const llvm::CallBase*>& NapiCallSiteIndex::callSitesIn(const llvm::Function* caller) const {
+    static const std::vector<const llvm::CallBase*> empty;
+    auto it = callSitesByCaller.find(caller);
+    return it == callSitesByCaller.end() ? empty : it->second;
+}
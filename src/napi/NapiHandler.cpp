@@ -1,4 +1,6 @@
 #include "napi/NapiHandler.h"
+#include "metrics/Metrics.h"
+#include "SVF-LLVM/LLVMModule.h"
 
 using namespace SVF;
 
@@ -12,7 +14,25 @@ void NapiHandler::registerHandler(const std::string& name, HandlerFunc func) {
     handlerMap[name] = func;
 }
 
-void NapiHandler::dispatch(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::Andersen* ander, std::vector<SummaryItem>& summaryItems) {
+void NapiHandler::bindModules() {
+    boundHandlers.clear();
+    for (const llvm::Module& module : LLVMModuleSet::getLLVMModuleSet()->getLLVMModules()) {
+        for (const llvm::Function& function : module) {
+            auto it = handlerMap.find(function.getName().str());
+            if (it != handlerMap.end()) {
+                boundHandlers[&function] = &it->second;
+            }
+        }
+    }
+    bound = true;
+}
+
+void NapiHandler::clearBindings() {
+    boundHandlers.clear();
+    bound = false;
+}
+
+void NapiHandler::dispatch(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::AndersenBase* ander, std::vector<SummaryItem>& summaryItems) {
     if (!llvm::isa<llvm::CallInst>(inst)) return;
 
     const llvm::CallBase* callInst = llvm::dyn_cast<llvm::CallBase>(inst);
@@ -21,10 +41,17 @@ void NapiHandler::dispatch(const llvm::Instruction* inst, TaintMap& taintMap, co
     const llvm::Function* callee = LLVMUtil::getCallee(callInst);
     if (!callee) return;
 
-    const std::string& calleeName = callee->getName().str();
-    auto it = handlerMap.find(calleeName);
-    if (it != handlerMap.end()) {
-        it->second(inst, taintMap, svfg, pag, ander, summaryItems);  // 调用注册的处理函数
+    const HandlerFunc* handler = nullptr;
+    if (bound) {
+        auto it = boundHandlers.find(callee);
+        if (it == boundHandlers.end()) return;  // 非 NAPI 函数
+        handler = it->second;
+    } else {
+        auto it = handlerMap.find(callee->getName().str());
+        if (it == handlerMap.end()) return;
+        handler = &it->second;
     }
+    Metrics::countHandlerInvocation();
+    (*handler)(inst, taintMap, svfg, pag, ander, summaryItems);  // 调用注册的处理函数
     return;
 }
\ No newline at end of file
@@ -25,7 +25,7 @@ using namespace SVF;
 //                                              uint32_t* result);
 // "napi_get_array_length"          // 用于在Node-API模块中获取ArkTS数组对象的长度。
 
-void handleNapiArrayFunction(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::Andersen* ander, std::vector<SummaryItem>& summaryItems) {
+void handleNapiArrayFunction(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::AndersenBase* ander, std::vector<SummaryItem>& summaryItems) {
     std::cout << "napi_array" << std::endl;
     const llvm::CallInst* callInst = llvm::dyn_cast<llvm::CallInst>(inst);
     if (!callInst) return;
@@ -48,7 +48,7 @@ void handleNapiArrayFunction(const llvm::Instruction* inst, TaintMap& taintMap,
     // 获取第一个参数
     const llvm::Value* envParam = callInst->getOperand(0);
     NodeID envParamNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(envParam);
-    int envID = taintMap.getParamIdByIndex(0); 
+    int envID = taintMap.getEnvId(); 
     if (envID == -1) {
         envID = taintMap.assignNewId(envParamNodeID);
     }
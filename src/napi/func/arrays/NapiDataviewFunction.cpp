@@ -27,7 +27,7 @@ using namespace SVF;
 //                                               napi_value* arraybuffer,
 //                                               size_t* byte_offset);
 
-void handleNapiDataviewFunction(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::Andersen* ander, std::vector<SummaryItem>& summaryItems) {
+void handleNapiDataviewFunction(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::AndersenBase* ander, std::vector<SummaryItem>& summaryItems) {
     std::cout << "napi_dataview" << std::endl;
     const llvm::CallInst* callInst = llvm::dyn_cast<llvm::CallInst>(inst);
     if (!callInst) return;
@@ -50,7 +50,7 @@ void handleNapiDataviewFunction(const llvm::Instruction* inst, TaintMap& taintMa
     // 获取第一个参数
     const llvm::Value* envParam = callInst->getOperand(0);
     NodeID envParamNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(envParam);
-    int envID = taintMap.getParamIdByIndex(0); 
+    int envID = taintMap.getEnvId(); 
     if (envID == -1) {
         envID = taintMap.assignNewId(envParamNodeID);
     }
@@ -30,7 +30,7 @@ using namespace SVF;
 //                                            uint32_t index,
 //                                            bool* result);
 
-void handleNapiElementFunction(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::Andersen* ander, std::vector<SummaryItem>& summaryItems) {
+void handleNapiElementFunction(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::AndersenBase* ander, std::vector<SummaryItem>& summaryItems) {
     std::cout << "napi_element" << std::endl;
     const llvm::CallInst* callInst = llvm::dyn_cast<llvm::CallInst>(inst);
     if (!callInst) return;
@@ -53,7 +53,7 @@ void handleNapiElementFunction(const llvm::Instruction* inst, TaintMap& taintMap
     // 获取第一个参数
     const llvm::Value* envParam = inst->getOperand(0);
     NodeID envParamNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(envParam);
-    int envID = taintMap.getParamIdByIndex(0); 
+    int envID = taintMap.getEnvId(); 
     if (envID == -1) {
         envID = taintMap.assignNewId(envParamNodeID);
     }
@@ -43,7 +43,7 @@ using namespace SVF;
 //	判断给定JS value是否为Buffer对象。
 
 
-void handleNapiCreateBufferFunction(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::Andersen* ander, std::vector<SummaryItem>& summaryItems) {
+void handleNapiCreateBufferFunction(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::AndersenBase* ander, std::vector<SummaryItem>& summaryItems) {
     std::cout << "napi_create_buffer" << std::endl;
     const llvm::CallInst* callInst = llvm::dyn_cast<llvm::CallInst>(inst);
     if (!callInst) return;
@@ -66,7 +66,7 @@ void handleNapiCreateBufferFunction(const llvm::Instruction* inst, TaintMap& tai
     // 获取第一个参数
     const llvm::Value* envParam = callInst->getOperand(0);
     NodeID envParamNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(envParam);
-    int envID = taintMap.getParamIdByIndex(0); 
+    int envID = taintMap.getEnvId(); 
     if (envID == -1) {
         envID = taintMap.assignNewId(envParamNodeID);
     }
@@ -7,6 +7,7 @@
 #include "Graphs/SVFG.h"
 #include "Graphs/VFGEdge.h"
 #include "napi/utils/ParseVFG.h"
+#include "scheduler/TaskOutput.h"
 #include <sstream>
 
 using namespace SVF;
@@ -18,10 +19,10 @@ using namespace SVF;
 //                                           const napi_value* argv,
 //                                           napi_value* result);
 
-void handleNapiCallFunction(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::Andersen* ander, std::vector<SummaryItem>& summaryItems) {
+void handleNapiCallFunction(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::AndersenBase* ander, std::vector<SummaryItem>& summaryItems) {
     const llvm::CallInst* callInst = llvm::dyn_cast<llvm::CallInst>(inst);
     if (!callInst) return;
-    inst->print(llvm::outs());
+    inst->print(TaskOutput::outs());
 
     std::string calledFunctionName = "";
 
@@ -37,12 +38,12 @@ void handleNapiCallFunction(const llvm::Instruction* inst, TaintMap& taintMap, c
         calledFunctionName = calledFunction->getName().str();
     }
     SummaryItem summaryItemResult(calledFunctionName, "Call");
-    callInst->print(llvm::outs());
+    callInst->print(TaskOutput::outs());
 
     const llvm::Value* envParam = callInst->getArgOperand(0);
-    envParam->print(llvm::outs());
+    envParam->print(TaskOutput::outs());
     NodeID envParamNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(envParam);
-    int envID = taintMap.getParamIdByIndex(0); 
+    int envID = taintMap.getEnvId(); 
     if (envID == -1) {
         envID = taintMap.assignNewId(envParamNodeID);
     }
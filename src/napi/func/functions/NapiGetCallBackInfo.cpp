@@ -18,58 +18,10 @@ using namespace SVF;
 //                      napi_value* thisArg,
 //                      void** data)
 
-int parseArgcValue(SVFVar* argcSVFVar, const SVFG* svfg, const SVFIR* pag, NodeID argcNodeID, PointerAnalysis* ander) {
-    const PointsTo& pts = ander->getPts(argcNodeID);
-    if (!pts.empty()) {
-        for (PointsTo::iterator it = pts.begin(); it != pts.end(); ++it) {
-            NodeID objId = *it; 
-            const SVFVar* objVar = pag->getGNode(objId);
-            if (!objVar) {
-                continue;
-            }
-
-            NodeID addrVarId = -1;
-            for (auto nit = svfg->begin(), nie = svfg->end(); nit != nie; ++nit) {
-                const SVFGNode* node = nit->second;
-                const AddrVFGNode* addrNode = SVFUtil::dyn_cast<AddrVFGNode>(node);
-                if (!addrNode) continue;
-                if (const StmtVFGNode* stmt = SVFUtil::dyn_cast<StmtVFGNode>(addrNode)) {
-                    NodeID srcId = stmt->getPAGSrcNodeID();
-                    NodeID dstId = stmt->getPAGDstNodeID();
-                    if (srcId == objId) {
-                        addrVarId = dstId; // VarX
-                        break;
-                    }
-                }
-            }
-
-            if (addrVarId != -1) {
-                for (auto nit = svfg->begin(), nie = svfg->end(); nit != nie; ++nit) {
-                    const SVFGNode* node = nit->second;
-                    if (const StoreVFGNode* storeNode = SVFUtil::dyn_cast<StoreVFGNode>(node)) {
-                        NodeID dstId = storeNode->getPAGDstNodeID();
-                        if (dstId == addrVarId || ander->alias(dstId, addrVarId) != SVF::AliasResult::NoAlias) {
-                            const SVFVar* storedValue = storeNode->getPAGSrcNode();
-                            if (const ConstIntValVar* constIntVar = SVFUtil::dyn_cast<ConstIntValVar>(storedValue)) {
-                                s64_t intValue = constIntVar->getSExtValue();
-                                std::cout << "The value of argc is: " << intValue << std::endl;
-                                return static_cast<int>(intValue);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    } else {
-        std::cerr << "Warning: No points-to information found for argc." << std::endl;
-    }
-
-    return -1;
-}
-
+// argc 的取值由 ParseVFG.cpp 中的 parseIntValue 解析
 // parseArgvValue 已移动到 ParseVFG.cpp，并在 ParseVFG.h 中声明
 
-void handleNapiGetCbInfo(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::Andersen* ander, std::vector<SummaryItem>& summaryItems) {
+void handleNapiGetCbInfo(const llvm::Instruction* inst, TaintMap& taintMap, const SVFG* svfg, const SVFIR* pag, SVF::AndersenBase* ander, std::vector<SummaryItem>& summaryItems) {
     
     const llvm::CallInst* callInst = llvm::dyn_cast<llvm::CallInst>(inst);
     if (!callInst) return;
@@ -92,7 +44,7 @@ void handleNapiGetCbInfo(const llvm::Instruction* inst, TaintMap& taintMap, cons
     // 获取第一个参数
     const llvm::Value* envParam = callInst->getArgOperand(0);
     NodeID envParamNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(envParam);
-    int envID = taintMap.getParamIdByIndex(0); // 直接使用第一个参数的paramId
+    int envID = taintMap.getEnvId(); // 直接使用导出函数第一个参数（napi_env）的编号
     if (envID == -1) {
         envID = taintMap.assignNewId(envParamNodeID);
     }
@@ -101,7 +53,7 @@ void handleNapiGetCbInfo(const llvm::Instruction* inst, TaintMap& taintMap, cons
     // 获取第二个参数
     const llvm::Value* cbInfoParam = callInst->getArgOperand(1);
     NodeID cbInfoParamNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(cbInfoParam);
-    int cbInfoID = taintMap.getParamIdByIndex(1); // 直接使用第二个参数的paramId
+    int cbInfoID = taintMap.getCallbackInfoId(); // 直接使用导出函数第二个参数（napi_callback_info）的编号
     if (cbInfoID == -1) {
         cbInfoID = taintMap.assignNewId(cbInfoParamNodeID);
     }
@@ -113,7 +65,7 @@ void handleNapiGetCbInfo(const llvm::Instruction* inst, TaintMap& taintMap, cons
     int argcValue = -1;
     if(argcNodeID != 0){
         SVFVar* argcSVFVar = pag->getGNode(argcNodeID);
-        argcValue = parseArgcValue(argcSVFVar, svfg, pag, argcNodeID, ander);
+        argcValue = parseIntValue(argcSVFVar, svfg, pag, argcNodeID, ander);
         if(argcValue == -1){
             summaryItemResult.addOperand("top");
         }
@@ -1,4 +1,8 @@
 #include "napi/utils/ParseVFG.h"
+#include "metrics/Metrics.h"
+#include "napi/utils/VFGIndex.h"
+#include "napi/utils/SliceCache.h"
+#include "taintanalysis/AnalysisBudget.h"
 #include "SVFIR/SVFIR.h"
 #include "SVF-LLVM/LLVMUtil.h"
 #include "SVF-LLVM/LLVMModule.h"
@@ -9,6 +13,7 @@
 #include "MemoryModel/AccessPath.h"
 #include <queue>
 #include <set>
+#include <unordered_set>
 using namespace SVF;
 
 std::pair<NodeID, int> parseLoadVFG(SVFVar* loadSVFVar, const SVFG* svfg, const SVFIR* pag) {
@@ -97,12 +102,20 @@ std::pair<NodeID, int> parseGepVFG(const SVFG* svfg, const SVFIR* pag, const SVF
 
 std::vector<NodeID> bfsPredecessors(const SVFG* svfg, const SVFIR* pag, const SVFVar* startSVFVar) {
     std::vector<NodeID> results;
-    std::set<const VFGNode*> visited;
-    std::queue<const VFGNode*> q;
+    // 同一函数的分析中反复查询的变量直接复用缓存的切片
+    if (SliceCache::lookup(svfg, startSVFVar->getId(), results)) {
+        Metrics::countSliceCacheHit();
+        return results;
+    }
+    Metrics::countSliceComputed();
+
+    std::unordered_set<NodeID> resultSet;
+    std::unordered_set<NodeID> visited;
+    std::queue<std::pair<const VFGNode*, size_t>> q;   // 节点及其与起点的距离
 
-    auto enqueue = [&](const VFGNode* n){ if(n) q.push(n); };
+    auto enqueue = [&](const VFGNode* n){ if(n) q.push({n, 0}); };
 
-    // 确定起点：优先用 Def 节点；若没有，则从全图中查找与该 Var 直接相关的语句节点
+    // 确定起点：优先用 Def 节点；若没有，则查找与该 Var 直接相关的语句节点（有索引时直接查索引，否则扫描全图）
     std::vector<const VFGNode*> startNodes;
     if (svfg->hasDefSVFGNode(startSVFVar)) {
         const VFGNode* startNode = svfg->getDefSVFGNode(startSVFVar);
@@ -110,24 +123,50 @@ std::vector<NodeID> bfsPredecessors(const SVFG* svfg, const SVFIR* pag, const SV
     }
     if (startNodes.empty()) {
         NodeID targetId = startSVFVar->getId();
-        for (auto it = svfg->begin(), ie = svfg->end(); it != ie; ++it) {
-            const VFGNode* node = it->second;
-            if (const StmtVFGNode* stmt = SVFUtil::dyn_cast<StmtVFGNode>(node)) {
-                if (stmt->getPAGDstNodeID() == targetId || stmt->getPAGSrcNodeID() == targetId) {
-                    startNodes.push_back(node);
+        if (const VFGIndex* index = VFGIndex::get(svfg)) {
+            const std::vector<const StmtVFGNode*>& stmts = index->stmtNodesOf(targetId);
+            startNodes.insert(startNodes.end(), stmts.begin(), stmts.end());
+        } else {
+            for (auto it = svfg->begin(), ie = svfg->end(); it != ie; ++it) {
+                const VFGNode* node = it->second;
+                Metrics::countSvfgNodeVisit();
+                if (const StmtVFGNode* stmt = SVFUtil::dyn_cast<StmtVFGNode>(node)) {
+                    if (stmt->getPAGDstNodeID() == targetId || stmt->getPAGSrcNodeID() == targetId) {
+                        startNodes.push_back(node);
+                    }
                 }
             }
         }
     }
     for (auto* n : startNodes) enqueue(n);
-    if (q.empty()) return results;
+    if (q.empty()) {
+        SliceCache::store(svfg, startSVFVar->getId(), results);
+        return results;
+    }
 
-    // 反向遍历所有进入边，收集可映射的 PAG NodeID，并打印详细调试信息
-    const size_t MAX_RESULTS = 20; // 设置最大结果数量限制
-    while(!q.empty() && results.size() < MAX_RESULTS){
-        const VFGNode* current = q.front();
+    // 反向遍历所有进入边，收集可映射的 PAG NodeID，并打印详细调试信息；
+    // 结果数与访问节点数受 SliceCache 配置的上限约束，降级重试时遍历深度另受 AnalysisBudget 约束（0 表示不限制）
+    const size_t maxResults = SliceCache::maxResults();
+    const size_t maxVisits = SliceCache::maxVisits();
+    const size_t maxDepth = AnalysisBudget::maxSliceDepth();
+    auto resultsFull = [&]() { return maxResults != 0 && results.size() >= maxResults; };
+    auto addResult = [&](NodeID nodeId) {
+        if (nodeId != 0 && resultSet.insert(nodeId).second) {
+            results.push_back(nodeId);
+        }
+    };
+    bool truncated = false;
+    while(!q.empty()){
+        // 线程模式下函数的截止时间已到时同样截断，调用方会丢弃本次结果
+        if (resultsFull() || (maxVisits != 0 && visited.size() >= maxVisits) || AnalysisBudget::expired()) {
+            truncated = true;
+            break;
+        }
+        const VFGNode* current = q.front().first;
+        size_t depth = q.front().second;
         q.pop();
-        if (!visited.insert(current).second) continue;
+        if (!visited.insert(current->getId()).second) continue;
+        Metrics::countSvfgNodeVisit();
 
         std::cout << "[SVFG][BFS] Visit Node #" << current->getId() << "\n";
         std::cout << current->toString() << std::endl;
@@ -138,28 +177,30 @@ std::vector<NodeID> bfsPredecessors(const SVFG* svfg, const SVFIR* pag, const SV
             std::cout << srcNode->toString() << std::endl;
 
             if (const StmtVFGNode* stmtNode = SVFUtil::dyn_cast<StmtVFGNode>(srcNode)){
-                NodeID srcNodeID = stmtNode->getPAGSrcNodeID();
-                NodeID dstNodeID = stmtNode->getPAGDstNodeID();
-                if (srcNodeID != 0 && std::find(results.begin(), results.end(), srcNodeID) == results.end()) {
-                    results.push_back(srcNodeID);
-                    if (results.size() >= MAX_RESULTS) break; // 达到限制时退出内层循环
-                }
-                if (dstNodeID != 0 && std::find(results.begin(), results.end(), dstNodeID) == results.end()) {
-                    results.push_back(dstNodeID);
-                    if (results.size() >= MAX_RESULTS) break; // 达到限制时退出内层循环
-                }
+                addResult(stmtNode->getPAGSrcNodeID());
+                if (resultsFull()) break; // 达到限制时退出内层循环
+                addResult(stmtNode->getPAGDstNodeID());
+                if (resultsFull()) break; // 达到限制时退出内层循环
             }
 
-            if (visited.find(srcNode) == visited.end()) {
-                q.push(srcNode);
+            if (visited.find(srcNode->getId()) == visited.end()) {
+                if (maxDepth != 0 && depth + 1 >= maxDepth) {
+                    truncated = true;   // 已收集该前驱的语句，不再继续向前展开
+                    continue;
+                }
+                q.push({srcNode, depth + 1});
             }
         }
     }
+    if (truncated) {
+        Metrics::countSliceTruncated();
+    }
+    SliceCache::store(svfg, startSVFVar->getId(), results);
     return results;
 }
 
 
-std::vector<NodeID> getTaintmapExistingNodes(std::vector<NodeID>& nodeIDs, TaintMap& taintMap, SVF::Andersen* ander) {
+std::vector<NodeID> getTaintmapExistingNodes(std::vector<NodeID>& nodeIDs, TaintMap& taintMap, SVF::AndersenBase* ander) {
     std::vector<NodeID> results = taintMap.getExistingNodes(nodeIDs, ander);
     return results;
 }
@@ -192,6 +233,19 @@ int getTaintmapNewID(NodeID nodeID, TaintMap& taintMap, const SVFG* svfg, const
 }
 
 int parseIntValue(const SVFVar* intSVFVar, const SVFG* svfg, const SVFIR* pag, NodeID intNodeId, PointerAnalysis* ander) {
+    // 有索引时查 Addr/Store 索引并复用已解析的结果，否则逐个扫描全图
+    if (const VFGIndex* index = VFGIndex::get(svfg)) {
+        if (ander->getPts(intNodeId).empty()) {
+            std::cerr << "Warning: No points-to information found for argc." << std::endl;
+            return -1;
+        }
+        int intValue = index->resolveIntValue(intNodeId);
+        if (intValue != -1) {
+            std::cout << "The value of argc is: " << intValue << std::endl;
+        }
+        return intValue;
+    }
+
     const PointsTo& pts = ander->getPts(intNodeId);
     if (!pts.empty()) {
         for (PointsTo::iterator it = pts.begin(); it != pts.end(); ++it) {
@@ -204,6 +258,7 @@ int parseIntValue(const SVFVar* intSVFVar, const SVFG* svfg, const SVFIR* pag, N
             NodeID addrVarId = -1;
             for (auto nit = svfg->begin(), nie = svfg->end(); nit != nie; ++nit) {
                 const SVFGNode* node = nit->second;
+                Metrics::countSvfgNodeVisit();
                 const AddrVFGNode* addrNode = SVFUtil::dyn_cast<AddrVFGNode>(node);
                 if (!addrNode) continue;
                 if (const StmtVFGNode* stmt = SVFUtil::dyn_cast<StmtVFGNode>(addrNode)) {
@@ -219,8 +274,12 @@ int parseIntValue(const SVFVar* intSVFVar, const SVFG* svfg, const SVFIR* pag, N
             if (addrVarId != -1) {
                 for (auto nit = svfg->begin(), nie = svfg->end(); nit != nie; ++nit) {
                     const SVFGNode* node = nit->second;
+                    Metrics::countSvfgNodeVisit();
                     if (const StoreVFGNode* storeNode = SVFUtil::dyn_cast<StoreVFGNode>(node)) {
                         NodeID dstId = storeNode->getPAGDstNodeID();
+                        if (dstId != addrVarId) {
+                            Metrics::countAliasQuery();
+                        }
                         if (dstId == addrVarId || ander->alias(dstId, addrVarId) != SVF::AliasResult::NoAlias) {
                             const SVFVar* storedValue = storeNode->getPAGSrcNode();
                             if (const ConstIntValVar* constIntVar = SVFUtil::dyn_cast<ConstIntValVar>(storedValue)) {
@@ -242,7 +301,7 @@ int parseIntValue(const SVFVar* intSVFVar, const SVFG* svfg, const SVFIR* pag, N
 
 void parseArgsOperand(const SVFG* svfg, const SVFIR* pag, NodeID valueParamNodeID, 
                     const SVFVar* valueSVFVar, TaintMap& taintMap, 
-                    std::vector<SummaryItem>& summaryItems, SummaryItem& summaryItemResult, int argc, SVF::Andersen* ander) {
+                    std::vector<SummaryItem>& summaryItems, SummaryItem& summaryItemResult, int argc, SVF::AndersenBase* ander) {
     std::vector<NodeID> preNodeIDs = bfsPredecessors(svfg, pag, valueSVFVar);
     std::vector<NodeID> existingNodeIDs = getTaintmapExistingNodes(preNodeIDs, taintMap, ander);
     if(existingNodeIDs.size() == 0){
@@ -258,7 +317,7 @@ void parseArgsOperand(const SVFG* svfg, const SVFIR* pag, NodeID valueParamNodeI
 }
 
 int handlePhi(const SVFG* svfg, const SVFIR* pag, const llvm::Value* valueParam,
-                    TaintMap& taintMap, std::vector<SummaryItem>& summaryItems, SVF::Andersen* ander) {
+                    TaintMap& taintMap, std::vector<SummaryItem>& summaryItems, SVF::AndersenBase* ander) {
     NodeID valueParamNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(valueParam);
     const SVFVar* valueSVFVar = pag->getGNode(valueParamNodeID);
     if(LLVMUtil::isNullPtrSym(valueParam)){
@@ -296,7 +355,7 @@ int handlePhi(const SVFG* svfg, const SVFIR* pag, const llvm::Value* valueParam,
 
 
 void handleTaintFlow(const SVFG* svfg, const SVFIR* pag, const llvm::Value* valueParam,
-                    TaintMap& taintMap, std::vector<SummaryItem>& summaryItems, SummaryItem& summaryItemResult, SVF::Andersen* ander) {
+                    TaintMap& taintMap, std::vector<SummaryItem>& summaryItems, SummaryItem& summaryItemResult, SVF::AndersenBase* ander) {
     NodeID valueParamNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(valueParam);
     const SVFVar* valueSVFVar = pag->getGNode(valueParamNodeID);
     if(LLVMUtil::isNullPtrSym(valueParam)){
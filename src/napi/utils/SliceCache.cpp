@@ -0,0 +1,70 @@
+#include "napi/utils/SliceCache.h"
+#include "config/EnvConfig.h"
+#include <unordered_map>
+
+using namespace SVF;
+
+namespace {
+    const long DEFAULT_MAX_RESULTS = 20;
+    const long DEFAULT_MAX_VISITS = 0;
+
+    struct SliceTable {
+        const SVFG* svfg = nullptr;
+        std::unordered_map<NodeID, std::vector<NodeID>> slices;
+    };
+
+    SliceTable& localTable() {
+        thread_local SliceTable table;
+        return table;
+    }
+
+    size_t readBudget(const char* name, long defaultValue) {
+        long value = EnvConfig::getLong(name, defaultValue);
+        return value > 0 ? static_cast<size_t>(value) : 0;
+    }
+}
+
+size_t SliceCache::maxResults() {
+    static const size_t value = readBudget("NAPI_SVF_SLICE_MAX_RESULTS", DEFAULT_MAX_RESULTS);
+    return value;
+}
+
+size_t SliceCache::maxVisits() {
+    static const size_t value = readBudget("NAPI_SVF_SLICE_MAX_VISITS", DEFAULT_MAX_VISITS);
+    return value;
+}
+
+std::string SliceCache::budgetTag() {
+    if (maxResults() == DEFAULT_MAX_RESULTS && maxVisits() == DEFAULT_MAX_VISITS) {
+        return "";
+    }
+    return "-slice" + std::to_string(maxResults()) + "x" + std::to_string(maxVisits());
+}
+
+bool SliceCache::lookup(const SVFG* svfg, NodeID startVar, std::vector<NodeID>& slice) {
+    SliceTable& table = localTable();
+    if (table.svfg != svfg) {
+        return false;
+    }
+    auto it = table.slices.find(startVar);
+    if (it == table.slices.end()) {
+        return false;
+    }
+    slice = it->second;
+    return true;
+}
+
+void SliceCache::store(const SVFG* svfg, NodeID startVar, const std::vector<NodeID>& slice) {
+    SliceTable& table = localTable();
+    if (table.svfg != svfg) {
+        table.slices.clear();
+        table.svfg = svfg;
+    }
+    table.slices[startVar] = slice;
+}
+
+void SliceCache::reset() {
+    SliceTable& table = localTable();
+    table.slices.clear();
+    table.svfg = nullptr;
+}
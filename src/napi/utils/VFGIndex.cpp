@@ -0,0 +1,129 @@
+#include "napi/utils/VFGIndex.h"
+#include "metrics/Metrics.h"
+
+using namespace SVF;
+
+std::mutex VFGIndex::registryMutex;
+std::unordered_map<const SVFG*, std::unique_ptr<VFGIndex>> VFGIndex::registry;
+
+void VFGIndex::build(const SVFG* svfg, PointerAnalysis* pta) {
+    if (!svfg || !pta || get(svfg)) {
+        return;
+    }
+    std::unique_ptr<VFGIndex> index = std::make_unique<VFGIndex>();
+    index->pta = pta;
+    // SVFG 按节点编号有序遍历，各桶内的节点顺序与原先的全图扫描一致
+    for (auto it = svfg->begin(), ie = svfg->end(); it != ie; ++it) {
+        Metrics::countSvfgNodeVisit();
+        const StmtVFGNode* stmt = SVFUtil::dyn_cast<StmtVFGNode>(it->second);
+        if (!stmt) {
+            continue;
+        }
+        NodeID srcId = stmt->getPAGSrcNodeID();
+        NodeID dstId = stmt->getPAGDstNodeID();
+        index->stmtNodesByVar[dstId].push_back(stmt);
+        if (srcId != dstId) {
+            index->stmtNodesByVar[srcId].push_back(stmt);
+        }
+
+        if (SVFUtil::isa<AddrVFGNode>(stmt)) {
+            // 只保留每个对象的第一个取地址变量，与按编号扫描时先命中的一致
+            index->addrVarByObj.emplace(srcId, dstId);
+        } else if (const StoreVFGNode* store = SVFUtil::dyn_cast<StoreVFGNode>(stmt)) {
+            if (!SVFUtil::isa<ConstIntValVar>(store->getPAGSrcNode())) {
+                continue;
+            }
+            index->constStores.push_back(store);
+            index->constStoresByDst[dstId].push_back(store);
+            PointsTo expanded;
+            pta->expandFIObjs(pta->getPts(dstId), expanded);
+            if (pta->containBlackHoleNode(expanded)) {
+                index->blackHoleConstStores.push_back(store);
+            }
+            for (NodeID objId : expanded) {
+                index->constStoresByObj[objId].push_back(store);
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry.emplace(svfg, std::move(index));
+}
+
+void VFGIndex::release(const SVFG* svfg) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry.erase(svfg);
+}
+
+const VFGIndex* VFGIndex::get(const SVFG* svfg) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = registry.find(svfg);
+    return it == registry.end() ? nullptr : it->second.get();
+}
+
+const std::vector<const StmtVFGNode*>& VFGIndex::stmtNodesOf(NodeID pagId) const {
+    static const std::vector<const StmtVFGNode*> empty;
+    auto it = stmtNodesByVar.find(pagId);
+    return it == stmtNodesByVar.end() ? empty : it->second;
+}
+
+const StoreVFGNode* VFGIndex::firstConstStoreInto(NodeID addrVarId) const {
+    if (constStores.empty()) {
+        return nullptr;
+    }
+    Metrics::countAliasQuery();
+    // 与 Andersen 的别名判断一致：任一方指向集含黑洞节点，或两者指向集相交；目标指针为该变量本身时直接命中
+    PointsTo expanded;
+    pta->expandFIObjs(pta->getPts(addrVarId), expanded);
+    if (pta->containBlackHoleNode(expanded)) {
+        return constStores.front();
+    }
+
+    // 各桶已按编号升序，只需比较各桶的第一个节点
+    const StoreVFGNode* best = nullptr;
+    auto consider = [&best](const std::vector<const StoreVFGNode*>& bucket) {
+        if (!bucket.empty() && (!best || bucket.front()->getId() < best->getId())) {
+            best = bucket.front();
+        }
+    };
+    auto dstIt = constStoresByDst.find(addrVarId);
+    if (dstIt != constStoresByDst.end()) {
+        consider(dstIt->second);
+    }
+    for (NodeID objId : expanded) {
+        auto objIt = constStoresByObj.find(objId);
+        if (objIt != constStoresByObj.end()) {
+            consider(objIt->second);
+        }
+    }
+    consider(blackHoleConstStores);
+    return best;
+}
+
+int VFGIndex::resolveIntValue(NodeID ptrNodeId) const {
+    {
+        std::lock_guard<std::mutex> lock(intValueMutex);
+        auto it = intValueCache.find(ptrNodeId);
+        if (it != intValueCache.end()) {
+            return it->second;
+        }
+    }
+
+    int value = -1;
+    const PointsTo& pts = pta->getPts(ptrNodeId);
+    for (PointsTo::iterator it = pts.begin(); it != pts.end(); ++it) {
+        auto addrIt = addrVarByObj.find(*it);
+        if (addrIt == addrVarByObj.end()) {
+            continue;
+        }
+        if (const StoreVFGNode* store = firstConstStoreInto(addrIt->second)) {
+            const ConstIntValVar* constIntVar = SVFUtil::cast<ConstIntValVar>(store->getPAGSrcNode());
+            value = static_cast<int>(constIntVar->getSExtValue());
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(intValueMutex);
+    intValueCache.emplace(ptrNodeId, value);
+    return value;
+}
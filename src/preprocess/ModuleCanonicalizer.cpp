@@ -0,0 +1,171 @@
+#include "preprocess/ModuleCanonicalizer.h"
+#include "config/EnvConfig.h"
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Scalar.h>
+#include <llvm/Transforms/Utils.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+    const Function* directCallee(const CallBase* callSite) {
+        return dyn_cast<Function>(callSite->getCalledOperand()->stripPointerCasts());
+    }
+
+    bool isNapiCall(const CallBase* callSite) {
+        const Function* callee = directCallee(callSite);
+        return callee && callee->isDeclaration() && callee->getName().startswith("napi_");
+    }
+
+    struct IRCounts {
+        size_t instructions = 0;
+        size_t allocas = 0;
+        size_t loads = 0;
+        size_t stores = 0;
+        size_t napiCallSites = 0;
+    };
+
+    IRCounts countIR(const Module& module) {
+        IRCounts counts;
+        for (const Function& func : module) {
+            for (const Instruction& inst : instructions(func)) {
+                counts.instructions++;
+                if (isa<AllocaInst>(inst)) {
+                    counts.allocas++;
+                } else if (isa<LoadInst>(inst)) {
+                    counts.loads++;
+                } else if (isa<StoreInst>(inst)) {
+                    counts.stores++;
+                } else if (const CallBase* callSite = dyn_cast<CallBase>(&inst)) {
+                    if (isNapiCall(callSite)) {
+                        counts.napiCallSites++;
+                    }
+                }
+            }
+        }
+        return counts;
+    }
+
+    nlohmann::json countsToJson(const IRCounts& counts) {
+        nlohmann::json json;
+        json["instructions"] = counts.instructions;
+        json["allocas"] = counts.allocas;
+        json["loads"] = counts.loads;
+        json["stores"] = counts.stores;
+        json["napi_call_sites"] = counts.napiCallSites;
+        return json;
+    }
+
+    // 只有一个基本块、指令数不超过上限、自身不调用 napi_* 也不递归的函数视为平凡包装函数
+    bool isTrivialWrapper(const Function& func, size_t instructionLimit) {
+        if (func.isDeclaration() || func.isVarArg() || func.hasFnAttribute(Attribute::NoInline) ||
+            func.size() != 1 || func.getInstructionCount() > instructionLimit) {
+            return false;
+        }
+        for (const Instruction& inst : instructions(func)) {
+            if (const CallBase* callSite = dyn_cast<CallBase>(&inst)) {
+                if (isNapiCall(callSite) || directCallee(callSite) == &func) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    size_t inlineTrivialWrappers(Module& module, size_t instructionLimit) {
+        std::vector<CallBase*> candidates;
+        for (Function& func : module) {
+            for (Instruction& inst : instructions(func)) {
+                CallBase* callSite = dyn_cast<CallBase>(&inst);
+                // 只内联类型完全匹配的直接调用
+                if (callSite && callSite->getCalledFunction() &&
+                    isTrivialWrapper(*callSite->getCalledFunction(), instructionLimit)) {
+                    candidates.push_back(callSite);
+                }
+            }
+        }
+        size_t inlined = 0;
+        for (CallBase* callSite : candidates) {
+            InlineFunctionInfo info;
+            // 不插入 lifetime 标记，避免给 PAG 增加无关的内建函数调用
+            if (InlineFunction(*callSite, info, nullptr, false).isSuccess()) {
+                inlined++;
+            }
+        }
+        return inlined;
+    }
+}
+
+bool ModuleCanonicalizer::isEnabled() {
+    return EnvConfig::getBool("NAPI_SVF_CANONICALIZE", false);
+}
+
+bool ModuleCanonicalizer::measurePAGEnabled() {
+    return EnvConfig::getBool("NAPI_SVF_CANONICALIZE_MEASURE", false);
+}
+
+bool ModuleCanonicalizer::canonicalize(Module& module, nlohmann::json& stats) {
+    IRCounts before = countIR(module);
+    size_t instructionLimit = static_cast<size_t>(EnvConfig::getLong("NAPI_SVF_CANONICALIZE_INLINE_LIMIT", 8));
+    size_t inlined = inlineTrivialWrappers(module, instructionLimit);
+
+    legacy::FunctionPassManager passes(&module);
+    passes.add(createSROAPass());
+    passes.add(createPromoteMemoryToRegisterPass());
+    passes.add(createInstSimplifyLegacyPass());
+    passes.add(createDeadCodeEliminationPass());
+    passes.doInitialization();
+    for (Function& func : module) {
+        if (!func.isDeclaration()) {
+            passes.run(func);
+        }
+    }
+    passes.doFinalization();
+
+    IRCounts after = countIR(module);
+    stats["inlined_call_sites"] = inlined;
+    stats["ir_before"] = countsToJson(before);
+    stats["ir_after"] = countsToJson(after);
+    return before.napiCallSites == after.napiCallSites;
+}
+
+bool ModuleCanonicalizer::canonicalizeToFile(const std::string& inputPath, const std::string& outputPath,
+                                             nlohmann::json& stats) {
+    LLVMContext context;
+    SMDiagnostic diagnostic;
+    std::unique_ptr<Module> module = parseIRFile(inputPath, diagnostic, context);
+    if (!module) {
+        errs() << "规范化：无法读取 " << inputPath << "\n";
+        return false;
+    }
+    if (!canonicalize(*module, stats)) {
+        errs() << "规范化：NAPI 调用点数目发生变化，使用未规范化的模块 " << inputPath << "\n";
+        return false;
+    }
+    if (verifyModule(*module, &errs())) {
+        errs() << "规范化：规范化后的模块校验失败，使用未规范化的模块 " << inputPath << "\n";
+        return false;
+    }
+
+    std::error_code ec;
+    raw_fd_ostream out(outputPath, ec, sys::fs::OF_None);
+    if (ec) {
+        errs() << "规范化：无法写入 " << outputPath << ": " << ec.message() << "\n";
+        return false;
+    }
+    WriteBitcodeToFile(*module, out);
+    out.close();
+    bool written = !out.has_error();
+    out.clear_error();
+    return written;
+}
@@ -0,0 +1,174 @@
+#include "preprocess/ModuleSlicer.h"
+#include "config/EnvConfig.h"
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/GlobalAlias.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/raw_ostream.h>
+#include <unordered_set>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+    // 从入口函数出发的可达闭包：函数经指令操作数传递，全局变量经初始值传递
+    class Reachability {
+    public:
+        void addRoot(const Function* func) { visitValue(func); }
+
+        void run() {
+            while (!functionWorklist.empty()) {
+                const Function* func = functionWorklist.back();
+                functionWorklist.pop_back();
+                if (func->isDeclaration()) {
+                    continue;
+                }
+                if (func->hasPersonalityFn()) {
+                    visitValue(func->getPersonalityFn());
+                }
+                for (const Instruction& inst : instructions(func)) {
+                    for (const Use& operand : inst.operands()) {
+                        visitValue(operand.get());
+                    }
+                }
+            }
+        }
+
+        bool isReachable(const Function* func) const { return reachedFunctions.count(func) != 0; }
+
+    private:
+        std::unordered_set<const Function*> reachedFunctions;
+        std::unordered_set<const Value*> visitedConstants;
+        std::vector<const Function*> functionWorklist;
+
+        void visitValue(const Value* root) {
+            std::vector<const Value*> stack{root};
+            while (!stack.empty()) {
+                const Value* value = stack.back();
+                stack.pop_back();
+                if (const Function* func = dyn_cast<Function>(value)) {
+                    if (reachedFunctions.insert(func).second) {
+                        functionWorklist.push_back(func);
+                    }
+                } else if (const GlobalVariable* global = dyn_cast<GlobalVariable>(value)) {
+                    if (visitedConstants.insert(global).second && global->hasInitializer()) {
+                        stack.push_back(global->getInitializer());
+                    }
+                } else if (const GlobalAlias* alias = dyn_cast<GlobalAlias>(value)) {
+                    if (visitedConstants.insert(alias).second) {
+                        stack.push_back(alias->getAliasee());
+                    }
+                } else if (isa<ConstantExpr>(value) || isa<ConstantAggregate>(value)) {
+                    if (visitedConstants.insert(value).second) {
+                        for (const Use& operand : cast<Constant>(value)->operands()) {
+                            stack.push_back(operand.get());
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    bool callsModuleRegister(const Function& func) {
+        for (const Instruction& inst : instructions(func)) {
+            if (const CallBase* callSite = dyn_cast<CallBase>(&inst)) {
+                const Function* callee = dyn_cast<Function>(callSite->getCalledOperand()->stripPointerCasts());
+                if (callee && callee->getName() == "napi_module_register") {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    size_t countInstructions(const Module& module) {
+        size_t count = 0;
+        for (const Function& func : module) {
+            count += func.getInstructionCount();
+        }
+        return count;
+    }
+}
+
+bool ModuleSlicer::isEnabled() {
+    return EnvConfig::getBool("NAPI_SVF_MODULE_SLICE", true);
+}
+
+long ModuleSlicer::slice(Module& module, nlohmann::json& stats) {
+    Reachability reachability;
+    size_t rootCount = 0;
+    for (const Function& func : module) {
+        if (func.isDeclaration()) {
+            continue;
+        }
+        // 注册调用的参数即 napi_module 结构体，其初始化函数经由全局变量的初始值可达
+        if (func.getName() == "napi_register_module_v1" || callsModuleRegister(func)) {
+            reachability.addRoot(&func);
+            rootCount++;
+        }
+    }
+    stats["roots"] = rootCount;
+    if (rootCount == 0) {
+        return -1;
+    }
+    reachability.run();
+
+    size_t definedBefore = 0;
+    size_t instructionsBefore = countInstructions(module);
+    std::vector<Function*> unreachable;
+    for (Function& func : module) {
+        if (func.isDeclaration()) {
+            continue;
+        }
+        definedBefore++;
+        if (!reachability.isReachable(&func)) {
+            unreachable.push_back(&func);
+        }
+    }
+    for (Function* func : unreachable) {
+        func->deleteBody();
+        func->setComdat(nullptr);   // 声明不能属于 comdat
+    }
+
+    stats["functions_defined_before"] = definedBefore;
+    stats["functions_pruned"] = unreachable.size();
+    stats["instructions_before"] = instructionsBefore;
+    stats["instructions_after"] = countInstructions(module);
+    return static_cast<long>(unreachable.size());
+}
+
+bool ModuleSlicer::sliceToFile(const std::string& inputPath, const std::string& outputPath, nlohmann::json& stats) {
+    LLVMContext context;
+    SMDiagnostic diagnostic;
+    std::unique_ptr<Module> module = parseIRFile(inputPath, diagnostic, context);
+    if (!module) {
+        errs() << "模块切片：无法读取 " << inputPath << "\n";
+        return false;
+    }
+    if (slice(*module, stats) < 0) {
+        errs() << "模块切片：未找到 NAPI 入口，使用完整模块 " << inputPath << "\n";
+        return false;
+    }
+    if (verifyModule(*module, &errs())) {
+        errs() << "模块切片：切片后的模块校验失败，使用完整模块 " << inputPath << "\n";
+        return false;
+    }
+
+    std::error_code ec;
+    raw_fd_ostream out(outputPath, ec, sys::fs::OF_None);
+    if (ec) {
+        errs() << "模块切片：无法写入 " << outputPath << ": " << ec.message() << "\n";
+        return false;
+    }
+    WriteBitcodeToFile(*module, out);
+    out.close();
+    bool written = !out.has_error();
+    out.clear_error();
+    return written;
+}
@@ -9,6 +9,15 @@
 namespace fs = std::filesystem;
 
 ProjectParser::ProjectParser(const std::string& path) : projectPath(path) {
+    parseProject();
+}
+
+ProjectParser::ProjectParser(const std::string& path, const LibraryCallback& onLibrary)
+    : projectPath(path), onLibrary(onLibrary) {
+    parseProject();
+}
+
+void ProjectParser::parseProject() {
     // 初始化日志目录
     logDir = fs::current_path() / "build_log";
     {
@@ -325,6 +334,9 @@ bool ProjectParser::extractBitcodeForFile(const std::string& soFile, std::string
     libraries.push_back(libInfo);
     
     logInfo(std::string("成功提取bitcode: ") + bcPath.string());
+    if (onLibrary) {
+        onLibrary(libInfo);
+    }
     return true;
 }
 
@@ -355,6 +367,27 @@ std::vector<std::string> ProjectParser::getLLVMIRFiles() const {
 }
 
 
+std::string ProjectParser::encodeLibraryInfo(const LibraryInfo& lib) {
+    nlohmann::json j;
+    j["name"] = lib.name;
+    j["so_name"] = lib.soName;
+    j["final_llvm_ir"] = lib.finalLLVMIR;
+    j["project_name"] = lib.projectName;
+    return j.dump();
+}
+
+bool ProjectParser::decodeLibraryInfo(const std::string& data, LibraryInfo& lib) {
+    nlohmann::json j = nlohmann::json::parse(data, nullptr, false);
+    if (j.is_discarded() || !j.is_object()) {
+        return false;
+    }
+    lib.name = j.value("name", "");
+    lib.soName = j.value("so_name", "");
+    lib.finalLLVMIR = j.value("final_llvm_ir", "");
+    lib.projectName = j.value("project_name", "");
+    return !lib.finalLLVMIR.empty();
+}
+
 const std::vector<LibraryInfo>& ProjectParser::getLibraries() const {
     return libraries;
 }
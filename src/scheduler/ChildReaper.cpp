@@ -0,0 +1,227 @@
+#include "scheduler/ChildReaper.h"
+#include <sys/signalfd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <iostream>
+#include <utility>
+
+namespace {
+    // SIGTERM 之后等待子进程自行退出的宽限时间
+    const int TERMINATE_GRACE_SECONDS = 2;
+}
+
+ChildReaper::ChildReaper() : signalFd(-1), wakeRequested(false) {
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    // 先屏蔽 SIGCHLD 再 fork，确保子进程退出的通知不会丢失
+    sigprocmask(SIG_BLOCK, &mask, &previousMask);
+    signalFd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signalFd < 0) {
+        std::cerr << "创建 signalfd 失败，退化为定时检查子进程状态\n";
+    }
+}
+
+ChildReaper::~ChildReaper() {
+    if (signalFd >= 0) {
+        close(signalFd);
+    }
+    for (auto& entry : children) {
+        if (entry.second.resultFd >= 0) {
+            close(entry.second.resultFd);
+        }
+    }
+    sigprocmask(SIG_SETMASK, &previousMask, nullptr);
+}
+
+void ChildReaper::detachInChild() {
+    if (signalFd >= 0) {
+        close(signalFd);
+        signalFd = -1;
+    }
+    for (auto& entry : children) {
+        if (entry.second.resultFd >= 0) {
+            close(entry.second.resultFd);
+        }
+    }
+    children.clear();
+    sigprocmask(SIG_SETMASK, &previousMask, nullptr);
+}
+
+void ChildReaper::watch(pid_t pid, int timeoutSeconds, const std::string& label, int resultFd) {
+    WatchedChild child;
+    child.label = label;
+    child.hasDeadline = timeoutSeconds > 0;
+    child.deadline = Clock::now() + std::chrono::seconds(timeoutSeconds > 0 ? timeoutSeconds : 0);
+    child.terminating = false;
+    child.killed = false;
+    child.resultFd = resultFd;
+    if (resultFd >= 0) {
+        int flags = fcntl(resultFd, F_GETFL, 0);
+        fcntl(resultFd, F_SETFL, flags | O_NONBLOCK);
+    }
+    children[pid] = child;
+}
+
+void ChildReaper::resetDeadline(pid_t pid, int timeoutSeconds) {
+    auto it = children.find(pid);
+    if (it == children.end() || it->second.terminating) {
+        return;
+    }
+    it->second.hasDeadline = timeoutSeconds > 0;
+    it->second.deadline = Clock::now() + std::chrono::seconds(timeoutSeconds > 0 ? timeoutSeconds : 0);
+}
+
+void ChildReaper::drainOutput(pid_t pid, WatchedChild& child) {
+    if (child.resultFd < 0) {
+        return;
+    }
+    size_t previousSize = child.output.size();
+    char buffer[65536];
+    while (true) {
+        ssize_t n = read(child.resultFd, buffer, sizeof(buffer));
+        if (n > 0) {
+            child.output.append(buffer, static_cast<size_t>(n));
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n == 0 || errno != EAGAIN) {
+            // 写端全部关闭（或出错），不再监听
+            close(child.resultFd);
+            child.resultFd = -1;
+        }
+        break;
+    }
+    if (outputHandler && child.output.size() != previousSize) {
+        outputHandler(pid, child.output);
+    }
+}
+
+void ChildReaper::collectExited(std::vector<ReapedChild>& reaped) {
+    for (auto it = children.begin(); it != children.end();) {
+        int status = 0;
+        struct rusage usage = {};
+        pid_t result = wait4(it->first, &status, WNOHANG, &usage);
+        if (result == 0) {
+            ++it;
+            continue;
+        }
+
+        WatchedChild& child = it->second;
+        // 子进程已退出，管道中剩余的数据可以一次读完
+        drainOutput(it->first, child);
+        ReapedChild done{it->first, child.label, !child.terminating, status, std::move(child.output),
+                         result > 0 ? usage.ru_maxrss : 0};
+        if (result < 0) {
+            std::cerr << "等待 " << child.label << " 进程 " << it->first << " 时出错\n";
+            done.completed = false;
+        } else if (child.terminating) {
+            std::cerr << child.label << " 进程 " << it->first << " 超时，已强制终止\n";
+        } else if (WIFEXITED(status)) {
+            std::cout << child.label << " 进程 " << it->first << " 正常完成\n";
+        } else if (WIFSIGNALED(status)) {
+            std::cout << child.label << " 进程 " << it->first << " 被信号终止\n";
+        }
+        reaped.push_back(done);
+        it = children.erase(it);
+    }
+}
+
+int ChildReaper::enforceDeadlines() {
+    Clock::time_point now = Clock::now();
+    bool hasWakeup = false;
+    Clock::time_point nextWakeup = now;
+
+    for (auto& entry : children) {
+        WatchedChild& child = entry.second;
+        if (!child.hasDeadline || child.killed) {
+            continue;
+        }
+        if (!child.terminating && now >= child.deadline) {
+            std::cerr << child.label << " 进程 " << entry.first << " 超时，发送 SIGTERM\n";
+            kill(entry.first, SIGTERM);
+            child.terminating = true;
+            child.killDeadline = now + std::chrono::seconds(TERMINATE_GRACE_SECONDS);
+        } else if (child.terminating && now >= child.killDeadline) {
+            kill(entry.first, SIGKILL);
+            child.killed = true;
+            continue;
+        }
+
+        Clock::time_point wakeup = child.terminating ? child.killDeadline : child.deadline;
+        if (!hasWakeup || wakeup < nextWakeup) {
+            nextWakeup = wakeup;
+            hasWakeup = true;
+        }
+    }
+
+    if (!hasWakeup) {
+        return -1;
+    }
+    auto waitMs = std::chrono::duration_cast<std::chrono::milliseconds>(nextWakeup - now).count();
+    return waitMs < 0 ? 0 : static_cast<int>(waitMs) + 1;
+}
+
+std::vector<ReapedChild> ChildReaper::waitAny() {
+    std::vector<ReapedChild> reaped;
+    wakeRequested = false;
+
+    while (!children.empty()) {
+        collectExited(reaped);
+        if (!reaped.empty() || wakeRequested) {
+            break;
+        }
+
+        int timeoutMs = enforceDeadlines();
+        if (signalFd < 0) {
+            // 没有 signalfd 时退化为短周期检查
+            timeoutMs = (timeoutMs < 0 || timeoutMs > 100) ? 100 : timeoutMs;
+        }
+
+        // 同时监听 SIGCHLD 与所有结果管道
+        std::vector<struct pollfd> pfds;
+        std::vector<pid_t> pfdOwners;
+        if (signalFd >= 0) {
+            pfds.push_back({signalFd, POLLIN, 0});
+            pfdOwners.push_back(0);
+        }
+        for (const auto& entry : children) {
+            if (entry.second.resultFd >= 0) {
+                pfds.push_back({entry.second.resultFd, POLLIN, 0});
+                pfdOwners.push_back(entry.first);
+            }
+        }
+
+        int ready = poll(pfds.data(), pfds.size(), timeoutMs);
+        if (ready < 0) {
+            if (errno != EINTR) {
+                std::cerr << "等待子进程事件时出错\n";
+            }
+            continue;
+        }
+        for (size_t i = 0; i < pfds.size() && ready > 0; i++) {
+            if (pfds[i].revents == 0) {
+                continue;
+            }
+            if (pfdOwners[i] == 0) {
+                // 读空 signalfd，多个 SIGCHLD 可能被合并为一次通知
+                struct signalfd_siginfo info;
+                while (read(signalFd, &info, sizeof(info)) == sizeof(info)) {
+                }
+            } else {
+                auto it = children.find(pfdOwners[i]);
+                if (it != children.end()) {
+                    drainOutput(it->first, it->second);
+                }
+            }
+        }
+    }
+
+    return reaped;
+}
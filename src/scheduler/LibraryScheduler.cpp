@@ -0,0 +1,223 @@
+#include "scheduler/LibraryScheduler.h"
+#include "config/EnvConfig.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <unordered_map>
+
+namespace {
+    const uint64_t MB = 1024ULL * 1024ULL;
+    // 尚无观测数据时使用的初始比例：SVF 的 PAG + Andersen + SVFG 通常为 bitcode 的数十倍
+    const long DEFAULT_BYTES_PER_BITCODE_BYTE = 40;
+    // 与 bitcode 大小无关的固定开销（LLVM/SVF 运行时、extapi.bc 等），不计入比例
+    const uint64_t BASE_BYTES = 128 * MB;
+}
+
+LibraryScheduler::LibraryScheduler(size_t width, uint64_t memoryCapBytes, int timeoutSeconds)
+    : width(width == 0 ? 1 : width), memoryCapBytes(memoryCapBytes), timeoutSeconds(timeoutSeconds), sourceSeconds(0.0),
+      bytesPerBitcodeByte(static_cast<double>(EnvConfig::getLong("NAPI_SVF_MEM_RATIO", DEFAULT_BYTES_PER_BITCODE_BYTE))),
+      sharedRunning(nullptr) {
+    if (bytesPerBitcodeByte < 1.0) {
+        bytesPerBitcodeByte = 1.0;
+    }
+    void* shared = mmap(nullptr, sizeof(std::atomic<unsigned>), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED) {
+        std::cerr << "无法映射共享内存，函数级并发宽度按库级宽度平分\n";
+    } else {
+        sharedRunning = new (shared) std::atomic<unsigned>(0);
+    }
+}
+
+LibraryScheduler::~LibraryScheduler() {
+    if (sharedRunning) {
+        munmap(sharedRunning, sizeof(std::atomic<unsigned>));
+    }
+}
+
+size_t LibraryScheduler::runningJobs() const {
+    // 无法共享计数时按最坏情况（所有槽位都在运行）计算
+    unsigned running = sharedRunning ? sharedRunning->load(std::memory_order_relaxed) : static_cast<unsigned>(width);
+    return running == 0 ? 1 : running;
+}
+
+size_t LibraryScheduler::defaultWidth() {
+    long onlineCores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (onlineCores < 1) {
+        onlineCores = 1;
+    }
+    long jobs = EnvConfig::getLong("NAPI_SVF_LIBRARY_JOBS", onlineCores);
+    return jobs < 1 ? 1 : static_cast<size_t>(jobs);
+}
+
+uint64_t LibraryScheduler::defaultMemoryCap() {
+    long capMb = EnvConfig::getLong("NAPI_SVF_MEM_CAP_MB", 0);
+    if (capMb > 0) {
+        return static_cast<uint64_t>(capMb) * MB;
+    }
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGE_SIZE);
+    if (pages <= 0 || pageSize <= 0) {
+        return 0;   // 无法获取物理内存时不限制
+    }
+    return static_cast<uint64_t>(pages) * static_cast<uint64_t>(pageSize) / 10 * 8;
+}
+
+uint64_t LibraryScheduler::estimate(const LibraryJob& job) const {
+    return BASE_BYTES + static_cast<uint64_t>(static_cast<double>(job.bitcodeBytes) * bytesPerBitcodeByte);
+}
+
+uint64_t LibraryScheduler::currentRssBytes(pid_t pid) {
+    std::ifstream status("/proc/" + std::to_string(pid) + "/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            return std::strtoull(line.c_str() + 6, nullptr, 10) * 1024ULL;
+        }
+    }
+    return 0;
+}
+
+size_t LibraryScheduler::addJob(const LibraryJob& job) {
+    size_t jobIndex = jobs.size();
+    jobs.push_back(job);
+    // 大库优先启动，小库随后填补剩余的内存与核；相同大小保持加入顺序
+    auto pos = std::upper_bound(pending.begin(), pending.end(), jobIndex, [&](size_t a, size_t b) {
+        return jobs[a].bitcodeBytes > jobs[b].bitcodeBytes;
+    });
+    pending.insert(pos, jobIndex);
+    return jobIndex;
+}
+
+void LibraryScheduler::run(const SourceTask& source, const SourceFrameCallback& onSourceFrame,
+                           const ChildTask& childTask, const DoneCallback& onDone) {
+    ChildReaper reaper;
+    std::unordered_map<pid_t, RunningJob> running;
+    pid_t sourcePid = -1;
+    auto sourceStart = std::chrono::steady_clock::now();
+
+    if (source) {
+        int sourcePipe[2];
+        if (pipe2(sourcePipe, O_CLOEXEC) != 0) {
+            std::cerr << "无法创建任务来源管道\n";
+        } else {
+            sourcePid = fork();
+            if (sourcePid == 0) {
+                reaper.detachInChild();
+                close(sourcePipe[0]);
+                source(sourcePipe[1]);
+                close(sourcePipe[1]);
+                exit(0);
+            }
+            close(sourcePipe[1]);
+            if (sourcePid < 0) {
+                std::cerr << "无法创建任务来源子进程\n";
+                close(sourcePipe[0]);
+            } else {
+                reaper.watch(sourcePid, 0, "任务来源", sourcePipe[0]);
+            }
+        }
+    }
+
+    // 任务来源的新任务随到随处理，并唤醒等待中的调度循环
+    reaper.setOutputHandler([&](pid_t pid, std::string& buffer) {
+        if (pid != sourcePid) {
+            return;
+        }
+        for (const Frame& frame : ResultChannel::parseFrames(buffer)) {
+            onSourceFrame(frame);
+        }
+        reaper.requestWake();
+    });
+
+    while (!pending.empty() || !reaper.empty()) {
+        // 运行中的库按"估算值与当前实际RSS的较大者"计入
+        uint64_t projected = 0;
+        for (const auto& entry : running) {
+            projected += std::max(entry.second.estimatedBytes, currentRssBytes(entry.first));
+        }
+
+        for (auto it = pending.begin(); it != pending.end() && running.size() < width;) {
+            size_t jobIndex = *it;
+            const LibraryJob& job = jobs[jobIndex];
+            uint64_t need = estimate(job);
+            bool fits = memoryCapBytes == 0 || projected + need <= memoryCapBytes;
+            if (!fits && !running.empty()) {
+                // 放不下则尝试更小的库
+                ++it;
+                continue;
+            }
+
+            int resultPipe[2];
+            if (pipe2(resultPipe, O_CLOEXEC) != 0) {
+                std::cerr << "无法为" << job.label << "创建结果管道\n";
+                it = pending.erase(it);
+                continue;
+            }
+            pid_t pid = fork();
+            if (pid < 0) {
+                std::cerr << "无法为" << job.label << "创建子进程\n";
+                close(resultPipe[0]);
+                close(resultPipe[1]);
+                it = pending.erase(it);
+                continue;
+            }
+            if (pid == 0) {
+                reaper.detachInChild();
+                close(resultPipe[0]);
+                childTask(jobIndex, resultPipe[1]);
+                close(resultPipe[1]);
+                exit(0);
+            }
+            close(resultPipe[1]);
+            reaper.watch(pid, timeoutSeconds, job.label, resultPipe[0]);
+            running[pid] = {jobIndex, need};
+            if (sharedRunning) {
+                sharedRunning->store(static_cast<unsigned>(running.size()), std::memory_order_relaxed);
+            }
+            projected += need;
+            it = pending.erase(it);
+            std::cout << "启动" << job.label << "进程 " << pid << "，预计内存 " << need / MB << " MB，"
+                      << "预计总占用 " << projected / MB << "/" << memoryCapBytes / MB << " MB，当前并发: "
+                      << running.size() << "/" << width << "\n";
+        }
+
+        if (reaper.empty()) {
+            continue;
+        }
+
+        for (const ReapedChild& child : reaper.waitAny()) {
+            if (child.pid == sourcePid) {
+                sourceSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - sourceStart).count();
+                continue;
+            }
+            auto it = running.find(child.pid);
+            if (it == running.end()) {
+                continue;
+            }
+            size_t jobIndex = it->second.jobIndex;
+            running.erase(it);
+            if (sharedRunning) {
+                sharedRunning->store(static_cast<unsigned>(running.size()), std::memory_order_relaxed);
+            }
+
+            // 用实际峰值RSS修正比例，之后的估算更接近真实值
+            const LibraryJob& job = jobs[jobIndex];
+            uint64_t peakBytes = static_cast<uint64_t>(child.maxRssKb) * 1024ULL;
+            if (peakBytes > BASE_BYTES && job.bitcodeBytes > 0) {
+                double observed = static_cast<double>(peakBytes - BASE_BYTES) / static_cast<double>(job.bitcodeBytes);
+                if (observed > bytesPerBitcodeByte) {
+                    bytesPerBitcodeByte = observed;
+                }
+                std::cout << job.label << " 峰值内存 " << child.maxRssKb / 1024 << " MB，内存估算比例更新为 "
+                          << bytesPerBitcodeByte << "\n";
+            }
+            onDone(jobIndex, child);
+        }
+    }
+}
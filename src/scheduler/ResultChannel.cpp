@@ -0,0 +1,71 @@
+#include "scheduler/ResultChannel.h"
+#include <unistd.h>
+#include <cerrno>
+
+namespace {
+    const size_t FRAME_HEADER_SIZE = 5;
+}
+
+bool ResultChannel::writeFrame(int fd, FrameType type, const std::string& payload) {
+    std::string frame;
+    frame.reserve(FRAME_HEADER_SIZE + payload.size());
+    frame.push_back(static_cast<char>(type));
+    uint32_t len = static_cast<uint32_t>(payload.size());
+    for (int i = 0; i < 4; i++) {
+        frame.push_back(static_cast<char>((len >> (8 * i)) & 0xff));
+    }
+    frame.append(payload);
+
+    size_t written = 0;
+    while (written < frame.size()) {
+        ssize_t n = write(fd, frame.data() + written, frame.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+std::vector<Frame> ResultChannel::parseFrames(std::string& buffer) {
+    std::vector<Frame> frames;
+    size_t pos = 0;
+    while (buffer.size() - pos >= FRAME_HEADER_SIZE) {
+        uint32_t len = 0;
+        for (int i = 0; i < 4; i++) {
+            len |= static_cast<uint32_t>(static_cast<unsigned char>(buffer[pos + 1 + i])) << (8 * i);
+        }
+        if (buffer.size() - pos - FRAME_HEADER_SIZE < len) {
+            break;
+        }
+        Frame frame;
+        frame.type = static_cast<FrameType>(buffer[pos]);
+        frame.payload = buffer.substr(pos + FRAME_HEADER_SIZE, len);
+        frames.push_back(std::move(frame));
+        pos += FRAME_HEADER_SIZE + len;
+    }
+    buffer.erase(0, pos);
+    return frames;
+}
+
+std::string ResultChannel::encodeTaskIndex(uint32_t taskIndex) {
+    std::string payload;
+    for (int i = 0; i < 4; i++) {
+        payload.push_back(static_cast<char>((taskIndex >> (8 * i)) & 0xff));
+    }
+    return payload;
+}
+
+bool ResultChannel::decodeTaskIndex(const std::string& payload, uint32_t& taskIndex) {
+    if (payload.size() != 4) {
+        return false;
+    }
+    taskIndex = 0;
+    for (int i = 0; i < 4; i++) {
+        taskIndex |= static_cast<uint32_t>(static_cast<unsigned char>(payload[i])) << (8 * i);
+    }
+    return true;
+}
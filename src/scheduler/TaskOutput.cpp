@@ -0,0 +1,89 @@
+#include "scheduler/TaskOutput.h"
+#include <iostream>
+#include <mutex>
+#include <streambuf>
+#include <string>
+
+namespace {
+    struct Capture {
+        bool active = false;
+        std::string buffer;
+        llvm::raw_string_ostream stream{buffer};
+    };
+
+    Capture& localCapture() {
+        thread_local Capture capture;
+        return capture;
+    }
+
+    // 装在 std::cout 上的分发缓冲：缓冲中的线程写入自己的 Capture，其余线程写入原来的缓冲
+    class DispatchBuf : public std::streambuf {
+    public:
+        explicit DispatchBuf(std::streambuf* original) : original(original) {}
+
+    protected:
+        int overflow(int ch) override {
+            if (ch == traits_type::eof()) {
+                return traits_type::not_eof(ch);
+            }
+            char c = traits_type::to_char_type(ch);
+            return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+        }
+
+        std::streamsize xsputn(const char* s, std::streamsize n) override {
+            Capture& capture = localCapture();
+            if (capture.active) {
+                capture.stream.write(s, static_cast<size_t>(n));
+                return n;
+            }
+            return original->sputn(s, n);
+        }
+
+        int sync() override {
+            return localCapture().active ? 0 : original->pubsync();
+        }
+
+    private:
+        std::streambuf* original;
+    };
+
+    std::mutex& writeMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    void installDispatch() {
+        static std::once_flag once;
+        std::call_once(once, []() {
+            std::cout.flush();
+            static DispatchBuf dispatch(std::cout.rdbuf());
+            std::cout.rdbuf(&dispatch);
+        });
+    }
+}
+
+llvm::raw_ostream& TaskOutput::outs() {
+    Capture& capture = localCapture();
+    return capture.active ? static_cast<llvm::raw_ostream&>(capture.stream) : llvm::outs();
+}
+
+TaskOutput::Scope::Scope() {
+    installDispatch();
+    Capture& capture = localCapture();
+    capture.stream.flush();
+    capture.buffer.clear();
+    capture.active = true;
+}
+
+TaskOutput::Scope::~Scope() {
+    Capture& capture = localCapture();
+    capture.active = false;
+    capture.stream.flush();
+    {
+        std::lock_guard<std::mutex> lock(writeMutex());
+        std::cout.flush();
+        llvm::outs() << capture.buffer;
+        llvm::outs().flush();
+    }
+    capture.buffer.clear();
+}
@@ -0,0 +1,149 @@
+#include "scheduler/ThreadPool.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void ThreadPool::parallelFor(size_t width, size_t taskCount, const Task& task) {
+    if (taskCount == 0) {
+        return;
+    }
+    if (width == 0) {
+        width = 1;
+    }
+    if (width > taskCount) {
+        width = taskCount;
+    }
+
+    std::atomic<size_t> nextTask(0);
+    auto worker = [&](size_t workerIndex) {
+        while (true) {
+            size_t taskIndex = nextTask.fetch_add(1);
+            if (taskIndex >= taskCount) {
+                break;
+            }
+            task(workerIndex, taskIndex);
+        }
+    };
+
+    // 当前线程也作为第 0 号工作线程参与
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < width; i++) {
+        threads.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::runDag(size_t width, const std::vector<std::vector<size_t>>& dependents,
+                        const std::vector<size_t>& dependencyCounts, const Task& task) {
+    const size_t taskCount = dependencyCounts.size();
+    if (taskCount == 0) {
+        return;
+    }
+    if (width == 0) {
+        width = 1;
+    }
+    if (width > taskCount) {
+        width = taskCount;
+    }
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    for (size_t i = 0; i < width; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    std::unique_ptr<std::atomic<size_t>[]> remaining(new std::atomic<size_t>[taskCount]);
+    std::atomic<size_t> readyCount(0);
+    std::atomic<size_t> completedCount(0);
+    std::mutex idleMutex;
+    std::condition_variable idleCondition;
+
+    auto push = [&](size_t workerIndex, size_t taskIndex) {
+        {
+            std::lock_guard<std::mutex> lock(queues[workerIndex]->mutex);
+            queues[workerIndex]->tasks.push_back(taskIndex);
+        }
+        readyCount.fetch_add(1);
+        std::lock_guard<std::mutex> lock(idleMutex);
+        idleCondition.notify_one();
+    };
+
+    // 初始没有依赖的任务轮流分给各个线程
+    size_t initialWorker = 0;
+    for (size_t i = 0; i < taskCount; i++) {
+        remaining[i].store(dependencyCounts[i]);
+    }
+    for (size_t i = 0; i < taskCount; i++) {
+        if (dependencyCounts[i] == 0) {
+            queues[initialWorker]->tasks.push_back(i);
+            readyCount.fetch_add(1);
+            initialWorker = (initialWorker + 1) % width;
+        }
+    }
+
+    auto tryTake = [&](size_t workerIndex, size_t& taskIndex) {
+        {
+            WorkQueue& own = *queues[workerIndex];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                taskIndex = own.tasks.back();
+                own.tasks.pop_back();
+                readyCount.fetch_sub(1);
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < width; offset++) {
+            WorkQueue& victim = *queues[(workerIndex + offset) % width];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                taskIndex = victim.tasks.front();
+                victim.tasks.pop_front();
+                readyCount.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto worker = [&](size_t workerIndex) {
+        while (completedCount.load() < taskCount) {
+            size_t taskIndex = 0;
+            if (!tryTake(workerIndex, taskIndex)) {
+                std::unique_lock<std::mutex> lock(idleMutex);
+                idleCondition.wait(lock, [&] {
+                    return readyCount.load() > 0 || completedCount.load() >= taskCount;
+                });
+                continue;
+            }
+            task(workerIndex, taskIndex);
+            for (size_t dependent : dependents[taskIndex]) {
+                if (remaining[dependent].fetch_sub(1) == 1) {
+                    push(workerIndex, dependent);
+                }
+            }
+            if (completedCount.fetch_add(1) + 1 == taskCount) {
+                std::lock_guard<std::mutex> lock(idleMutex);
+                idleCondition.notify_all();
+            }
+        }
+    };
+
+    // 当前线程也作为第 0 号工作线程参与
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < width; i++) {
+        threads.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
@@ -0,0 +1,246 @@
+#include "scheduler/WorkerPool.h"
+#include "scheduler/ChildReaper.h"
+#include "config/EnvConfig.h"
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // 尚无耗时数据时的初始批大小
+    const size_t INITIAL_BATCH_SIZE = 2;
+    // 单任务耗时滑动平均的权重
+    const double COST_SMOOTHING = 0.3;
+    // 子进程在任务之间退出时，未开始的任务重新排队而不计入执行次数；
+    // 同一任务因此重新排队的次数上限，防止子进程总在启动时失败而无限循环
+    const unsigned MAX_UNSTARTED_REQUEUES = 3;
+
+    // 一个批处理子进程的执行进度
+    struct BatchWorker {
+        std::vector<size_t> batch;     // 分配给该子进程的任务
+        size_t begun = 0;              // 已收到 TaskBegin 的任务数
+        bool inTask = false;           // 是否有任务正在执行（已 Begin 未 End）
+        Clock::time_point taskStart;
+        std::vector<Frame> taskFrames; // 当前任务已收到、尚未提交的结果帧
+    };
+}
+
+WorkerPool::WorkerPool(size_t width, int timeoutSeconds, const std::string& processName, unsigned maxAttempts)
+    : width(width == 0 ? 1 : width), timeoutSeconds(timeoutSeconds), processName(processName),
+      maxAttempts(maxAttempts == 0 ? 1 : maxAttempts), averageTaskMs(0.0), hasTaskSample(false) {
+    long maxBatch = EnvConfig::getLong("NAPI_SVF_BATCH_MAX", 32);
+    maxBatchSize = maxBatch < 1 ? 1 : static_cast<size_t>(maxBatch);
+    long targetMs = EnvConfig::getLong("NAPI_SVF_BATCH_TARGET_MS", 2000);
+    targetBatchMs = targetMs < 1 ? 1.0 : static_cast<double>(targetMs);
+}
+
+size_t WorkerPool::defaultWidth(size_t runningLibraries) {
+    long onlineCores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (onlineCores < 1) {
+        onlineCores = 1;
+    }
+    long share = onlineCores / static_cast<long>(runningLibraries == 0 ? 1 : runningLibraries);
+    long jobs = EnvConfig::getLong("NAPI_SVF_JOBS", share);
+    return jobs < 1 ? 1 : static_cast<size_t>(jobs);
+}
+
+size_t WorkerPool::getWidth() const {
+    if (!widthSource) {
+        return width;
+    }
+    size_t current = widthSource();
+    return current == 0 ? 1 : current;
+}
+
+size_t WorkerPool::nextBatchSize(size_t remainingTasks) const {
+    size_t size = INITIAL_BATCH_SIZE;
+    if (hasTaskSample) {
+        size = averageTaskMs <= 0.0 ? maxBatchSize : static_cast<size_t>(targetBatchMs / averageTaskMs);
+    }
+    // 不让少数子进程领走全部剩余任务，保证所有槽位都有活干
+    size_t currentWidth = getWidth();
+    size_t fairShare = (remainingTasks + currentWidth - 1) / currentWidth;
+    if (size > fairShare) {
+        size = fairShare;
+    }
+    if (size > maxBatchSize) {
+        size = maxBatchSize;
+    }
+    return size < 1 ? 1 : size;
+}
+
+void WorkerPool::recordTaskCost(double elapsedMs) {
+    if (!hasTaskSample) {
+        averageTaskMs = elapsedMs;
+        hasTaskSample = true;
+    } else {
+        averageTaskMs = COST_SMOOTHING * elapsedMs + (1.0 - COST_SMOOTHING) * averageTaskMs;
+    }
+}
+
+int WorkerPool::timeoutFor(unsigned attempt) const {
+    int timeout = timeoutSeconds;
+    for (unsigned i = 0; i < attempt && timeout > 1; i++) {
+        timeout /= 2;
+    }
+    return timeout;
+}
+
+void WorkerPool::run(size_t taskCount, const ChildTask& childTask, const FrameCallback& onFrame, const FailureCallback& onFailure) {
+    ChildReaper reaper;
+    std::unordered_map<pid_t, BatchWorker> workers;
+    std::deque<size_t> pending;         // 待分配的任务
+    std::deque<size_t> retries;         // 崩溃或超时后需要单独重试的任务
+    std::vector<unsigned> attempts(taskCount, 0);
+    std::vector<unsigned> unstartedRequeues(taskCount, 0);
+    std::vector<TaskFailure> failures(taskCount);   // 各任务已开始的执行的失败经过
+    auto giveUp = [&](size_t taskIndex, bool startFailed) {
+        failures[taskIndex].startFailed = startFailed;
+        onFailure(taskIndex, failures[taskIndex]);
+    };
+    for (size_t i = 0; i < taskCount; i++) {
+        pending.push_back(i);
+    }
+
+    // 解析子进程的结果帧：Begin/End 用于跟踪进度与续期，其余帧归属于当前任务，
+    // 暂存到 End 到达后才一并交给 onFrame；任务在 End 之前退出时丢弃，与失败后的重试不冲突
+    reaper.setOutputHandler([&](pid_t pid, std::string& buffer) {
+        auto it = workers.find(pid);
+        if (it == workers.end()) {
+            return;
+        }
+        BatchWorker& worker = it->second;
+        for (const Frame& frame : ResultChannel::parseFrames(buffer)) {
+            uint32_t taskIndex = 0;
+            if (frame.type == FrameType::TaskBegin) {
+                if (ResultChannel::decodeTaskIndex(frame.payload, taskIndex)) {
+                    worker.begun++;
+                    worker.inTask = true;
+                    worker.taskStart = Clock::now();
+                    worker.taskFrames.clear();
+                    reaper.resetDeadline(pid, timeoutFor(attempts[taskIndex]));
+                    attempts[taskIndex]++;
+                }
+            } else if (frame.type == FrameType::TaskEnd) {
+                if (ResultChannel::decodeTaskIndex(frame.payload, taskIndex)) {
+                    worker.inTask = false;
+                    recordTaskCost(std::chrono::duration<double, std::milli>(Clock::now() - worker.taskStart).count());
+                    for (const Frame& taskFrame : worker.taskFrames) {
+                        onFrame(worker.batch[worker.begun - 1], taskFrame);
+                    }
+                    worker.taskFrames.clear();
+                }
+            } else if (worker.inTask) {
+                worker.taskFrames.push_back(frame);
+            }
+        }
+    });
+
+    while (!pending.empty() || !retries.empty() || !reaper.empty()) {
+        // 有空闲槽位时立即启动下一批；重试的任务单独成批，避免再次拖累其他任务
+        while ((!pending.empty() || !retries.empty()) && reaper.size() < getWidth()) {
+            BatchWorker worker;
+            if (!retries.empty()) {
+                worker.batch.push_back(retries.front());
+                retries.pop_front();
+            } else {
+                size_t batchSize = nextBatchSize(pending.size());
+                for (size_t i = 0; i < batchSize && !pending.empty(); i++) {
+                    worker.batch.push_back(pending.front());
+                    pending.pop_front();
+                }
+            }
+
+            int resultPipe[2];
+            if (pipe2(resultPipe, O_CLOEXEC) != 0) {
+                std::cerr << "无法为" << processName << "创建结果管道\n";
+                for (size_t taskIndex : worker.batch) {
+                    giveUp(taskIndex, true);
+                }
+                continue;
+            }
+            pid_t pid = fork();
+            if (pid < 0) {
+                std::cerr << "无法为" << processName << "创建子进程\n";
+                close(resultPipe[0]);
+                close(resultPipe[1]);
+                for (size_t taskIndex : worker.batch) {
+                    giveUp(taskIndex, true);
+                }
+                continue;
+            }
+            if (pid == 0) {
+                reaper.detachInChild();
+                close(resultPipe[0]);
+                for (size_t taskIndex : worker.batch) {
+                    uint32_t index = static_cast<uint32_t>(taskIndex);
+                    ResultChannel::writeFrame(resultPipe[1], FrameType::TaskBegin, ResultChannel::encodeTaskIndex(index));
+                    childTask(taskIndex, attempts[taskIndex], resultPipe[1]);
+                    ResultChannel::writeFrame(resultPipe[1], FrameType::TaskEnd, ResultChannel::encodeTaskIndex(index));
+                }
+                close(resultPipe[1]);
+                exit(0);
+            }
+            close(resultPipe[1]);
+            // 重试的任务超时减半，初始计时与日志都按批中第一个任务的执行次数计算
+            int firstTimeout = timeoutFor(attempts[worker.batch.front()]);
+            reaper.watch(pid, firstTimeout, processName, resultPipe[0]);
+            size_t batchSize = worker.batch.size();
+            workers[pid] = std::move(worker);
+            std::cout << "启动" << processName << "子进程 " << pid << "（" << batchSize << " 个任务），单任务超时限制: "
+                      << firstTimeout << " 秒，当前并发: " << reaper.size() << "/" << getWidth() << "\n";
+        }
+
+        if (reaper.empty()) {
+            continue;
+        }
+
+        for (const ReapedChild& child : reaper.waitAny()) {
+            auto it = workers.find(child.pid);
+            if (it == workers.end()) {
+                continue;
+            }
+            BatchWorker worker = std::move(it->second);
+            workers.erase(it);
+
+            size_t firstUnstarted = worker.begun;
+            if (worker.inTask) {
+                // 只有正在执行的任务计入失败；在任务之间退出时没有任务需要负责
+                size_t failedPos = worker.begun - 1;
+                if (failedPos < worker.batch.size()) {
+                    size_t failedTask = worker.batch[failedPos];
+                    failures[failedTask].attempts.push_back(child.completed ? AttemptOutcome::Crashed
+                                                                            : AttemptOutcome::TimedOut);
+                    if (attempts[failedTask] < maxAttempts) {
+                        std::cerr << processName << "任务 " << failedTask << (child.completed ? " 崩溃" : " 超时")
+                                  << "，单独重试\n";
+                        retries.push_back(failedTask);
+                    } else {
+                        giveUp(failedTask, false);
+                    }
+                    firstUnstarted = failedPos + 1;
+                }
+            }
+            // 未开始的任务放回队首，保持原有顺序
+            bool exitedCleanly = child.completed && WIFEXITED(child.status) && WEXITSTATUS(child.status) == 0;
+            for (size_t pos = worker.batch.size(); pos > firstUnstarted; pos--) {
+                size_t taskIndex = worker.batch[pos - 1];
+                // 只有紧接着的那个任务可能与子进程的异常退出有关，只为它计数
+                bool blamed = !exitedCleanly && !worker.inTask && pos - 1 == firstUnstarted;
+                if (blamed && ++unstartedRequeues[taskIndex] > MAX_UNSTARTED_REQUEUES) {
+                    std::cerr << processName << "任务 " << taskIndex << " 多次未能开始执行，放弃\n";
+                    giveUp(taskIndex, true);
+                    continue;
+                }
+                pending.push_front(taskIndex);
+            }
+        }
+    }
+}
@@ -7,6 +7,7 @@
 #include "SVF-LLVM/SVFIRBuilder.h"
 #include "Util/Options.h"
 #include "napi/utils/ReadArkts.h"
+#include "napi/utils/SliceCache.h"
 #include "napi/AnalyzeProperties.h"
 #include "taintanalysis/TaintTracker.h"
 #include "taintanalysis/TaintList.h"
@@ -14,14 +15,31 @@
 #include "Util/WorkList.h"
 #include <nlohmann/json.hpp>
 #include "projectParser/ProjectParser.h"
+#include "scheduler/WorkerPool.h"
+#include "scheduler/ChildReaper.h"
+#include "scheduler/LibraryScheduler.h"
+#include "scheduler/ResultChannel.h"
+#include "scheduler/TaskOutput.h"
+#include "scheduler/ThreadPool.h"
+#include "config/EnvConfig.h"
+#include "incremental/IRHasher.h"
+#include "incremental/SummaryManifest.h"
+#include "taintanalysis/SummaryCodec.h"
+#include "taintanalysis/AnalysisBudget.h"
+#include "JsonExporter/SummaryExporter.h"
+#include "metrics/Metrics.h"
+#include "taintanalysis/SummaryEngine.h"
+#include "core/AnalysisContext.h"
 #include <sys/wait.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <signal.h>
 #include <cstdlib> // for getenv
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <fstream>
+#include <memory>
 using namespace llvm;
 using namespace std;
 using namespace SVF;
@@ -56,46 +74,6 @@ public:
     }
 };
 
-// 超时管理辅助函数
-bool waitProcessWithTimeout(pid_t pid, int timeoutSeconds, const std::string& processName) {
-    auto startTime = std::chrono::high_resolution_clock::now();
-    int status;
-    
-    while (true) {
-        pid_t result = waitpid(pid, &status, WNOHANG);
-        
-        if (result > 0) {
-            // 进程正常结束
-            if (WIFEXITED(status)) {
-                SVFUtil::outs() << processName << " 进程 " << pid << " 正常完成\n";
-            } else if (WIFSIGNALED(status)) {
-                SVFUtil::outs() << processName << " 进程 " << pid << " 被信号终止\n";
-            }
-            return true;
-        } else if (result == 0) {
-            // 进程仍在运行，检查超时
-            auto now = std::chrono::high_resolution_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - startTime);
-            
-            if (elapsed.count() >= timeoutSeconds) {
-                // 超时，强制终止
-                SVFUtil::errs() << processName << " 进程 " << pid << " 超时，强制终止\n";
-                kill(pid, SIGTERM);
-                sleep(2);
-                if (waitpid(pid, &status, WNOHANG) == 0) {
-                    kill(pid, SIGKILL);
-                    waitpid(pid, &status, 0);
-                }
-                return false;
-            }
-            sleep(1); // 等待1秒后再检查
-        } else {
-            SVFUtil::errs() << "等待 " << processName << " 进程 " << pid << " 时出错\n";
-            return false;
-        }
-    }
-}
-
 // 时间统计结构
 struct TimeStats {
     std::string libraryName;
@@ -104,6 +82,8 @@ struct TimeStats {
     double propertyAnalysisTime = 0.0;
     double taintAnalysisTime = 0.0;
     double totalLibraryTime = 0.0;
+    bool anderCacheHit = false;
+    nlohmann::json metrics;   // 库级指标记录，含各函数的测量结果
     
     void writeToFile(const std::string& outputPath) const {
         nlohmann::json timeJson;
@@ -114,6 +94,8 @@ struct TimeStats {
             {"taint_analysis_time_seconds", taintAnalysisTime},
             {"total_library_time_seconds", totalLibraryTime}
         };
+        timeJson["ander_cache_hit"] = anderCacheHit;
+        timeJson["metrics"] = metrics;
         
         std::string timeFile = outputPath + ".timing.json";
         std::ofstream file(timeFile);
@@ -232,9 +214,24 @@ void traverseOnVFG(const SVFG* vfg, const SVFVar* svfval, PAG* pag)
 }
 
 
-/// 对单个库进行SVF分析并生成JSON输出
-TimeStats analyzeSingleLibrary(const LibraryInfo& lib) {
+// 收集函数参数对应的 SVF 节点及名称，作为污点分析的初始参数
+static std::vector<std::pair<NodeID, std::string>> collectParamNodeIDs(SVFIR* pag, llvm::Function* function) {
+    std::vector<std::pair<NodeID, std::string>> paramNodeIDs;
+    for(auto& arg : function->args()) {
+        Value* argVal = &arg;
+        NodeID argNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(argVal);
+        SVFVar* svfVar = pag->getGNode(argNodeID);
+        std::string argname = svfVar->getValueName();
+        paramNodeIDs.push_back(std::make_pair(argNodeID, argname));
+    }
+    return paramNodeIDs;
+}
+
+/// 对单个库进行SVF分析并生成JSON输出；functionWidth 给出当前的函数级并发宽度，
+/// 在开始函数分析时取值（fork 模式下之后随时重新取值），此时 SVF 构造已完成，运行中的库数较为稳定
+TimeStats analyzeSingleLibrary(const LibraryInfo& lib, const WorkerPool::WidthSource& functionWidth) {
     Timer totalTimer("库 " + lib.name + " 总分析");
+    MetricsProbe libraryProbe(true);
     TimeStats stats;
     stats.libraryName = lib.name;
 
@@ -252,53 +249,27 @@ TimeStats analyzeSingleLibrary(const LibraryInfo& lib) {
     // 构建输出文件路径
     std::string outputfilename = (projectDir / (lib.soName + ".ir.json")).string();
 
-    // 设置模块向量，使用所有的LLVM IR文件
-    std::vector<std::string> moduleNameVec;
-    moduleNameVec.push_back(lib.finalLLVMIR);
-    // if (const char* svfDir = std::getenv("SVF_DIR")) {
-    //     moduleNameVec.push_back(std::string(svfDir) + "/lib/extapi.bc");
-    // } else {
-    //     SVFUtil::errs() << "环境变量 SVF_DIR 未设置，无法添加 extapi.bc\n";
-    // }
-
     // SVF构造计时开始
     Timer svfTimer("SVF构造");
     SVFUtil::outs() << "开始SVF构造 for " << lib.name << "\n";
 
-    if (Options::WriteAnder() == "ir_annotator") {
-        LLVMModuleSet::preProcessBCs(moduleNameVec);
-    }
-
-    LLVMModuleSet::buildSVFModule(moduleNameVec);
-
-    /// Build Program Assignment Graph (SVFIR)
-    SVFIRBuilder builder;
-    SVFIR* pag = builder.build();
-
-    /// Create Andersen's pointer analysis
-    Andersen* ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
-
-    /// Call Graph
-    CallGraph* callgraph = ander->getCallGraph();
-
-    /// ICFG
-    ICFG* icfg = pag->getICFG();
-
-    /// Value-Flow Graph (VFG)
-    VFG* vfg = new VFG(callgraph);
-
-    /// Sparse value-flow graph (SVFG)
-    SVFGBuilder svfBuilder;
-    SVFG* svfg = svfBuilder.buildFullSVFG(ander);
+    // 本库的 PAG、指针分析、调用图与值流图统一由分析上下文构建和释放
+    std::unique_ptr<AnalysisContext> context = std::make_unique<AnalysisContext>(lib.finalLLVMIR);
+    stats.anderCacheHit = context->andersenCacheHit();
+    const std::string analysisTier = AnalysisContext::tierName(context->analysisTier());
+    SVFIR* pag = context->getPAG();
+    AndersenBase* ander = context->getPointerAnalysis();
+    SVFG* svfg = context->getSVFG();
 
     stats.svfConstructionTime = svfTimer.elapsed();
     svfTimer.printElapsed();
 
     // 属性解析计时开始
     Timer propertyTimer("属性解析");
+    MetricsProbe propertyProbe;
     SVFUtil::outs() << "开始属性解析 for " << lib.name << "\n";
 
-    std::set<llvm::GlobalVariable*> globalVars = NapiPropertiesAnalyzer::analyzeNapiProperties(svfg, pag);
+    std::set<llvm::GlobalVariable*> globalVars = NapiPropertiesAnalyzer::analyzeNapiProperties(svfg, pag, ander);
     std::map<std::string, llvm::Function*> llvmfunctions = NapiPropertiesAnalyzer::analyzeGlobalVars(globalVars);
 
     // 添加对通过napi_set_named_property注册的函数的分析
@@ -309,97 +280,265 @@ TimeStats analyzeSingleLibrary(const LibraryInfo& lib) {
 
     stats.propertyAnalysisTime = propertyTimer.elapsed();
     propertyTimer.printElapsed();
+    // 库级计数器 = 属性解析阶段 + 各函数的计数之和（函数可能在其他线程或子进程中分析）
+    MetricCounters libraryCounters = propertyProbe.counters();
 
     // 污点分析计时开始
     Timer taintTimer("污点分析");
     SVFUtil::outs() << "开始污点分析 for " << lib.name << "\n";
 
-    TaintTracker taintTracker(pag, ander, svfg, vfg);
     nlohmann::json allResults = nlohmann::json::array();
+    std::vector<std::pair<std::string, llvm::Function*>> functionList(llvmfunctions.begin(), llvmfunctions.end());
+    // 结果按函数序号落位，输出顺序与并发调度无关
+    std::vector<nlohmann::json> functionResults(functionList.size());
+    // 各函数的指标记录，复用上次摘要的函数没有记录
+    std::vector<nlohmann::json> functionMetrics(functionList.size());
+
+    // 增量分析：调用闭包IR哈希未变化的函数直接复用上次的摘要，只分析发生变化的函数
+    const bool incremental = SummaryManifest::isEnabled();
+    SummaryManifest manifest((projectDir / (lib.soName + ".manifest.json")).string());
+    std::vector<std::string> closureHashes(functionList.size());
+    std::vector<bool> reused(functionList.size(), false);
+    // 以降低的预算档位得出摘要的函数（线程模式下各线程写入不同元素，不使用按位压缩的 vector<bool>）
+    std::vector<char> degraded(functionList.size(), 0);
+    std::vector<size_t> dirtyFunctions;
+    if (incremental) {
+        manifest.load();
+        IRHasher irHasher;
+        for (size_t funcIndex = 0; funcIndex < functionList.size(); funcIndex++) {
+            // 两种摘要模式的结果不可互换，模式、非默认的切片上限与降级的精度档位记入哈希
+            closureHashes[funcIndex] = irHasher.hashClosure(functionList[funcIndex].second) +
+                                       (SummaryEngine::isEnabled() ? "-compositional" : "") +
+                                       SliceCache::budgetTag() +
+                                       (context->analysisTier() == AnalysisTier::Full ? "" : "-" + analysisTier);
+            const nlohmann::json* stored = manifest.lookup(functionList[funcIndex].first, closureHashes[funcIndex]);
+            if (stored) {
+                functionResults[funcIndex] = *stored;
+                reused[funcIndex] = true;
+            } else {
+                dirtyFunctions.push_back(funcIndex);
+            }
+        }
+        SVFUtil::outs() << "增量分析: " << functionList.size() - dirtyFunctions.size() << " 个函数复用上次结果，"
+                        << dirtyFunctions.size() << " 个函数需要重新分析\n";
+    } else {
+        for (size_t funcIndex = 0; funcIndex < functionList.size(); funcIndex++) {
+            dirtyFunctions.push_back(funcIndex);
+        }
+    }
 
-    // 为每个函数创建子进程进行分析
-    std::vector<pid_t> function_pids;
-    std::vector<std::string> tempFileNames;
-    int funcIndex = 0;
+    // thread 模式（默认）在同一份只读 SVF 图上并发分析，省去 fork 与按批回传的开销；
+    // 单函数超时以协作式截止时间实现（AnalysisBudget），到期的函数按更低的预算档位重试。
+    // fork 模式以进程隔离崩溃与超时，单个函数崩溃或耗尽内存时不会拖垮整个库
+    const std::string taintMode = EnvConfig::getString("NAPI_SVF_TAINT_MODE", "thread");
+    // 单函数超时，两种模式相同；每降一个预算档位减半
     const int TIMEOUT_MINUTES = 10;
     const int TIMEOUT_SECONDS = TIMEOUT_MINUTES * 60;
-
-    for (auto& func : llvmfunctions) {
-        std::string funcName = func.first;
-        std::string tempFileName = "/tmp/taint_result_" + lib.name + "_" + std::to_string(funcIndex) + "_" + std::to_string(getpid()) + ".json";
-        tempFileNames.push_back(tempFileName);
-        
-        pid_t pid = fork();
-        
-        if (pid < 0) {
-            SVFUtil::errs() << "无法为函数 " << funcName << " 创建子进程\n";
-            continue;
+    // 最终失败的函数按实际经过记录错误结果（不写入清单，下次重新分析）：第 i 次执行对应第 i 个预算档位，
+    // 最后一次执行超时则标记 timeout，崩溃则标记 crashed，未能开始执行则标记 not_started
+    auto failureResult = [&](size_t funcIndex, const WorkerPool::TaskFailure& failure) {
+        std::string error;
+        std::string message;
+        for (size_t attempt = 0; attempt < failure.attempts.size(); attempt++) {
+            bool timedOut = failure.attempts[attempt] == WorkerPool::AttemptOutcome::TimedOut;
+            const char* budget = AnalysisBudget::levelName(
+                static_cast<AnalysisBudget::Level>(std::min<size_t>(attempt, AnalysisBudget::Minimal)));
+            error += std::string(attempt == 0 ? "" : ", ") + (timedOut ? "timed out" : "crashed") + " at " + budget +
+                     (timedOut ? " (" + std::to_string(AnalysisBudget::timeoutFor(TIMEOUT_SECONDS, attempt)) + "s)" : "");
+            message += std::string(attempt == 0 ? "" : "，") + budget + " 档位" + (timedOut ? "超时" : "崩溃");
         }
-        else if (pid == 0) {
-            // 子进程：分析单个函数
-            taintTracker.initializeFunctionArgs(func.second);
-            std::vector<std::pair<NodeID, std::string>> paramNodeIDs;
-
-            for(auto& arg : func.second->args()) {
-                Value* argVal = &arg;
-                NodeID argNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(argVal);
-                SVFVar* svfVar = pag->getGNode(argNodeID);
-                std::string argname = svfVar->getValueName();
-                paramNodeIDs.push_back(std::make_pair(argNodeID, argname));
-            }
+        if (failure.startFailed) {
+            error += failure.attempts.empty() ? "never started" : ", then never started again";
+            message += failure.attempts.empty() ? "未能开始执行" : "，之后未能开始执行";
+        }
+        std::cerr << "函数 " << functionList[funcIndex].first << " 分析失败：" << message << "\n";
+
+        nlohmann::json result;
+        result["name"] = functionList[funcIndex].first;
+        result["error"] = "Analysis failed: " + error;
+        if (failure.startFailed) {
+            result["not_started"] = true;
+        } else if (!failure.attempts.empty()) {
+            result[failure.attempts.back() == WorkerPool::AttemptOutcome::TimedOut ? "timeout" : "crashed"] = true;
+        }
+        if (!failure.attempts.empty()) {
+            // 最后一次已开始的执行所用的档位
+            result["analysis_budget"] = AnalysisBudget::levelName(
+                static_cast<AnalysisBudget::Level>(std::min<size_t>(failure.attempts.size() - 1, AnalysisBudget::Minimal)));
+        }
+        return result;
+    };
+    const size_t threadCount = std::max<size_t>(functionWidth(), 1);
+    bool concurrentQueriesReady = false;
+    auto prepareConcurrentQueries = [&]() {
+        if (concurrentQueriesReady) {
+            return;
+        }
+        TaintTracker::prepareForConcurrentQueries(pag, ander);
+        concurrentQueriesReady = true;
+    };
 
-            nlohmann::json outputJson = taintTracker.Traceker(func.second, paramNodeIDs, funcName);
-            
-            // 将结果写入临时文件
-            std::ofstream tempFile(tempFileName);
-            if (tempFile.is_open()) {
-                tempFile << outputJson.dump();
-                tempFile.close();
-            }
-            
-            exit(0); // 子进程完成
+    // 组合式摘要：内部函数按调用图自底向上各分析一次，导出函数在调用点实例化被调函数的摘要。
+    // 互不依赖的强连通分量并行计算，单个分量与导出函数一样受单函数超时与预算档位阶梯约束；
+    // 摘要在分叉/启动线程分析导出函数之前完成，之后只读共享
+    SummaryEngine summaryEngine(pag, ander, svfg);
+    const bool compositional = SummaryEngine::isEnabled() && !dirtyFunctions.empty();
+    if (compositional) {
+        Timer summaryTimer("内部函数摘要");
+        std::vector<const llvm::Function*> roots;
+        for (size_t funcIndex : dirtyFunctions) {
+            roots.push_back(functionList[funcIndex].second);
         }
-        else {
-            // 父进程：记录子进程PID
-            function_pids.push_back(pid);
-            SVFUtil::outs() << "启动子进程 " << pid << " 分析函数 " << funcName << "，超时限制: " << TIMEOUT_MINUTES << " 分钟\n";
+        if (threadCount > 1) {
+            prepareConcurrentQueries();
         }
-        
-        funcIndex++;
+        libraryCounters += summaryEngine.build(roots, threadCount, TIMEOUT_SECONDS);
+        summaryTimer.printElapsed();
     }
 
-    // 父进程等待所有函数分析子进程完成并收集结果
-    for (size_t i = 0; i < function_pids.size(); i++) {
-        pid_t child_pid = function_pids[i];
-        bool completed = waitProcessWithTimeout(child_pid, TIMEOUT_SECONDS, "函数分析");
-        
-        // 读取临时文件中的结果
-        if (completed) {
-            std::ifstream tempFile(tempFileNames[i]);
-            if (tempFile.is_open()) {
-                std::string jsonStr((std::istreambuf_iterator<char>(tempFile)),
-                                   std::istreambuf_iterator<char>());
-                tempFile.close();
-                
-                if (!jsonStr.empty()) {
-                    // 简单的JSON解析，不使用异常处理
-                    nlohmann::json resultJson = nlohmann::json::parse(jsonStr, nullptr, false);
-                    if (!resultJson.is_discarded()) {
-                        allResults.push_back(resultJson);
+    if (dirtyFunctions.empty()) {
+        SVFUtil::outs() << "所有函数均复用上次结果，跳过污点分析\n";
+    } else if (taintMode == "fork") {
+        TaintTracker taintTracker(*context);
+        if (compositional) {
+            taintTracker.setSummaryEngine(&summaryEngine);
+        }
+
+        // 子进程按批分析函数，批大小随单函数耗时自适应；超时按函数计时。
+        // 超时或崩溃的函数按 AnalysisBudget 的档位逐级降低代价重试，每次重试的超时时间减半；
+        // 组合式模式下被调函数摘要已预先算好（各自带有得出时的档位），重试只收紧反向遍历深度与别名回退
+
+        WorkerPool functionPool(threadCount, TIMEOUT_SECONDS, "函数分析", AnalysisBudget::LEVEL_COUNT);
+        functionPool.setWidthSource(functionWidth);
+        SVFUtil::outs() << "函数分析并发宽度: " << functionPool.getWidth() << "，单函数超时限制: " << TIMEOUT_MINUTES << " 分钟\n";
+
+        functionPool.run(dirtyFunctions.size(),
+            [&](size_t taskIndex, unsigned attempt, int resultFd) {
+                // 子进程：分析批次中的一个函数
+                size_t funcIndex = dirtyFunctions[taskIndex];
+                const std::string& funcName = functionList[funcIndex].first;
+                llvm::Function* function = functionList[funcIndex].second;
+                AnalysisBudget::setLevel(attempt);
+                SVFUtil::outs() << "子进程 " << getpid() << " 分析函数 " << funcName << "（预算档位 "
+                                << AnalysisBudget::levelName(AnalysisBudget::level()) << "）\n";
+
+                MetricsProbe functionProbe;
+                taintTracker.initializeFunctionArgs(function);
+                FunctionSummary summary = taintTracker.traceSummary(function, collectParamNodeIDs(pag, function), funcName);
+
+                // 以二进制编码通过结果管道回传
+                std::string payload;
+                SummaryCodec::encode(summary, payload);
+                if (!ResultChannel::writeFrame(resultFd, FrameType::FunctionSummary, payload)) {
+                    std::cerr << "函数 " << funcName << " 的结果写入管道失败\n";
+                }
+                ResultChannel::writeFrame(resultFd, FrameType::Metrics, functionProbe.finish(funcName).dump());
+            },
+            [&](size_t taskIndex, const auto& frame) {
+                // 父进程：任务正常结束（收到 TaskEnd）后才交出其结果帧，提交结果与清单
+                size_t funcIndex = dirtyFunctions[taskIndex];
+                if (frame.type == FrameType::Metrics) {
+                    nlohmann::json record = nlohmann::json::parse(frame.payload, nullptr, false);
+                    if (!record.is_discarded()) {
+                        functionMetrics[funcIndex] = record;
                     }
+                    return;
+                }
+                if (frame.type != FrameType::FunctionSummary) {
+                    return;
+                }
+                FunctionSummary summary;
+                if (SummaryCodec::decode(frame.payload.data(), frame.payload.size(), summary)) {
+                    functionResults[funcIndex] = SummaryExporter::toJson(summary);
+                    // 降级得到的摘要不写入清单，下次以完整预算重新分析
+                    degraded[funcIndex] = summary.budget != AnalysisBudget::levelName(AnalysisBudget::Full);
+                    if (incremental && !degraded[funcIndex]) {
+                        manifest.record(functionList[funcIndex].first, closureHashes[funcIndex], functionResults[funcIndex]);
+                    }
+                } else {
+                    std::cerr << "函数 " << functionList[funcIndex].first << " 的结果解码失败\n";
+                }
+            },
+            [&](size_t taskIndex, const WorkerPool::TaskFailure& failure) {
+                size_t funcIndex = dirtyFunctions[taskIndex];
+                functionResults[funcIndex] = failureResult(funcIndex, failure);
+            });
+    } else {
+        SVFUtil::outs() << "函数分析模式: 多线程，并发宽度: " << threadCount << "，单函数超时限制: " << TIMEOUT_MINUTES
+                        << " 分钟\n";
+
+        prepareConcurrentQueries();
+
+        // 每个线程持有独立的 TaintTracker
+        std::vector<std::unique_ptr<TaintTracker>> trackers;
+        for (size_t i = 0; i < threadCount; i++) {
+            trackers.push_back(std::make_unique<TaintTracker>(*context));
+            trackers.back()->setVerbose(false);
+            if (compositional) {
+                trackers.back()->setSummaryEngine(&summaryEngine);
+            }
+        }
+
+        ThreadPool::parallelFor(threadCount, dirtyFunctions.size(), [&](size_t workerIndex, size_t taskIndex) {
+            // 处理函数的调试输出按函数缓冲，分析结束后整块写出，不同函数的输出不交错
+            TaskOutput::Scope output;
+            size_t funcIndex = dirtyFunctions[taskIndex];
+            const std::string& funcName = functionList[funcIndex].first;
+            llvm::Function* function = functionList[funcIndex].second;
+            SVFUtil::outs() << "线程 " << workerIndex << " 分析函数 " << funcName << "\n";
+
+            MetricsProbe functionProbe;
+            TaintTracker& tracker = *trackers[workerIndex];
+            // 与 fork 模式相同的预算阶梯：截止时间到期则丢弃结果，按下一档位、减半的时限重试
+            bool finished = false;
+            FunctionSummary summary;
+            for (unsigned attempt = 0; attempt < AnalysisBudget::LEVEL_COUNT && !finished; attempt++) {
+                AnalysisBudget::setLevel(attempt);
+                AnalysisBudget::setDeadline(AnalysisBudget::timeoutFor(TIMEOUT_SECONDS, attempt));
+                tracker.initializeFunctionArgs(function);
+                summary = tracker.traceSummary(function, collectParamNodeIDs(pag, function), funcName);
+                finished = !AnalysisBudget::expired();
+                if (!finished) {
+                    SVFUtil::outs() << "函数 " << funcName << " 在预算档位 " << AnalysisBudget::levelName(AnalysisBudget::level())
+                                    << " 超时\n";
+                }
+            }
+            AnalysisBudget::clearDeadline();
+            AnalysisBudget::setLevel(AnalysisBudget::Full);
+            if (finished) {
+                functionResults[funcIndex] = SummaryExporter::toJson(summary);
+                degraded[funcIndex] = summary.budget != AnalysisBudget::levelName(AnalysisBudget::Full);
+            } else {
+                WorkerPool::TaskFailure failure;
+                failure.attempts.assign(AnalysisBudget::LEVEL_COUNT, WorkerPool::AttemptOutcome::TimedOut);
+                functionResults[funcIndex] = failureResult(funcIndex, failure);
+            }
+            functionMetrics[funcIndex] = functionProbe.finish(funcName);
+        });
+
+        if (incremental) {
+            // 降级或失败的结果不写入清单，下次以完整预算重新分析
+            for (size_t funcIndex : dirtyFunctions) {
+                if (!degraded[funcIndex] && !functionResults[funcIndex].contains("error")) {
+                    manifest.record(functionList[funcIndex].first, closureHashes[funcIndex], functionResults[funcIndex]);
                 }
             }
-        } else {
-            // 进程被强杀，记录超时结果
-            nlohmann::json timeoutResult;
-            timeoutResult["function_name"] = "timeout_killed";
-            timeoutResult["error"] = "Process killed due to timeout (" + std::to_string(TIMEOUT_MINUTES) + " minutes)";
-            timeoutResult["timeout"] = true;
-            allResults.push_back(timeoutResult);
         }
-        
-        // 删除临时文件
-        std::remove(tempFileNames[i].c_str());
+    }
+
+    for (size_t funcIndex = 0; funcIndex < functionList.size(); funcIndex++) {
+        const nlohmann::json& result = functionResults[funcIndex];
+        if (result.is_null()) {
+            continue;
+        }
+        // 复用的摘要同样写回清单，清单始终覆盖本次出现的全部函数
+        if (reused[funcIndex]) {
+            manifest.record(functionList[funcIndex].first, closureHashes[funcIndex], result);
+        }
+        allResults.push_back(result);
+    }
+    if (incremental && !manifest.save()) {
+        SVFUtil::errs() << "增量分析清单写入失败\n";
     }
 
     // 创建最终的 JSON 对象
@@ -407,6 +546,7 @@ TimeStats analyzeSingleLibrary(const LibraryInfo& lib) {
     finalJson["hap_name"] = lib.name;
     finalJson["so_name"] = lib.soName;
     finalJson["module_name"] = lib.name;
+    finalJson["analysis_tier"] = analysisTier;
     finalJson["functions"] = allResults;
 
     JsonOutput::writeToFile(outputfilename, finalJson.dump(4, ' ', false));
@@ -415,16 +555,33 @@ TimeStats analyzeSingleLibrary(const LibraryInfo& lib) {
     taintTimer.printElapsed();
 
     // 清理内存
-    delete vfg;
-    vfg = nullptr;
-    AndersenWaveDiff::releaseAndersenWaveDiff();
-    SVFIR::releaseSVFIR();
-    LLVMModuleSet::getLLVMModuleSet()->dumpModulesToFile(".svf.bc");
-    SVF::LLVMModuleSet::releaseLLVMModuleSet();
+    nlohmann::json vfgStats = context->vfgStats();
+    nlohmann::json preprocessStats = context->preprocessStats();
+    context.reset();
 
     stats.totalLibraryTime = totalTimer.elapsed();
     totalTimer.printElapsed();
 
+    nlohmann::json functionRecords = nlohmann::json::array();
+    for (const nlohmann::json& record : functionMetrics) {
+        if (record.is_null()) {
+            continue;
+        }
+        libraryCounters += Metrics::countersFromJson(record);
+        functionRecords.push_back(record);
+    }
+    stats.metrics = libraryProbe.finish(lib.name);
+    stats.metrics.update(Metrics::countersToJson(libraryCounters));
+    stats.metrics["svf_construction_time_seconds"] = stats.svfConstructionTime;
+    stats.metrics["property_analysis_time_seconds"] = stats.propertyAnalysisTime;
+    stats.metrics["taint_analysis_time_seconds"] = stats.taintAnalysisTime;
+    stats.metrics["ander_cache_hit"] = stats.anderCacheHit;
+    stats.metrics["analysis_tier"] = analysisTier;
+    stats.metrics["functions_degraded"] = std::count(degraded.begin(), degraded.end(), 1);
+    stats.metrics.update(vfgStats);
+    stats.metrics.update(preprocessStats);
+    stats.metrics["functions"] = functionRecords;
+
     // 写入单个库的时间统计文件
     stats.writeToFile(outputfilename);
 
@@ -445,65 +602,105 @@ int main(int argc, char ** argv)
     // 项目解析计时
     Timer parsingTimer("项目解析");
     SVFUtil::outs() << "开始解析项目: " << argv[1] << "\n";
-    
-    // 调用ProjectParser解析项目
-    ProjectParser projectParser(argv[1]);
-    std::vector<LibraryInfo> libraries = projectParser.getLibraries();
-    
-    double projectParsingTime = parsingTimer.elapsed();
-    parsingTimer.printElapsed();
-    
-    SVFUtil::outs() << "共发现 " << libraries.size() << " 个库需要分析\n";
+
+    std::vector<LibraryInfo> libraries;
+    double projectParsingTime = 0.0;
     
     // 存储所有库的时间统计
     std::vector<TimeStats> allLibraryStats;
+    // 所有库的指标记录，生产模式下由各库子进程通过结果管道回传
+    std::vector<nlohmann::json> libraryMetrics;
 
     if (DEBUG_MODE) {
+        // 调用ProjectParser解析项目
+        ProjectParser projectParser(argv[1]);
+        libraries = projectParser.getLibraries();
+
+        projectParsingTime = parsingTimer.elapsed();
+        parsingTimer.printElapsed();
+
+        SVFUtil::outs() << "共发现 " << libraries.size() << " 个库需要分析\n";
+
         // 调试模式：串行处理每个库
         SVFUtil::outs() << "使用调试模式：串行处理库\n";
         for (const LibraryInfo& lib : libraries) {
             SVFUtil::outs() << "开始分析库: " << lib.name << "\n";
-            TimeStats stats = analyzeSingleLibrary(lib);
+            TimeStats stats = analyzeSingleLibrary(lib, []() { return WorkerPool::defaultWidth(); });
             allLibraryStats.push_back(stats);
+            libraryMetrics.push_back(stats.metrics);
         }
     } else {
         // 生产模式：使用多进程
         SVFUtil::outs() << "使用生产模式：多进程处理库\n";
-        std::vector<pid_t> child_pids;
         const int LIBRARY_TIMEOUT_MINUTES = 30; // 库级别超时时间：30分钟
         const int LIBRARY_TIMEOUT_SECONDS = LIBRARY_TIMEOUT_MINUTES * 60;
-        
-        // 对每个库启动独立进程进行SVF分析
-        for (const LibraryInfo& lib : libraries) {
-            pid_t pid = fork();
-            
-            if (pid < 0) {
-                // fork失败
-                SVFUtil::errs() << "无法为库 " << lib.name << " 创建子进程\n";
-                continue;
-            } 
-            else if (pid == 0) {
+
+        // 按 bitcode 大小估算内存，预计总占用不超过上限时才启动新的库
+        LibraryScheduler libraryScheduler(LibraryScheduler::defaultWidth(), LibraryScheduler::defaultMemoryCap(),
+                                          LIBRARY_TIMEOUT_SECONDS);
+        SVFUtil::outs() << "库分析并发宽度: " << libraryScheduler.getWidth() << "，内存上限: "
+                        << libraryScheduler.getMemoryCap() / (1024 * 1024) << " MB，超时限制: "
+                        << LIBRARY_TIMEOUT_MINUTES << " 分钟\n";
+        // 核数按当前实际运行的库数平分给各库的函数级并发，避免 库数 × 函数数 的进程/线程同时运行；
+        // 只剩少数库时它们各自分到更多的核
+        const WorkerPool::WidthSource functionWidth = [&libraryScheduler]() {
+            return WorkerPool::defaultWidth(libraryScheduler.runningJobs());
+        };
+
+        // 项目构建在独立子进程中进行（其中会切换工作目录），每提取出一个库就立即加入分析队列，
+        // 构建其余项目与分析已就绪的库同时进行
+        libraryScheduler.run(
+            [&](int resultFd) {
+                ProjectParser projectParser(argv[1], [&](const LibraryInfo& lib) {
+                    ResultChannel::writeFrame(resultFd, FrameType::LibraryReady, ProjectParser::encodeLibraryInfo(lib));
+                });
+            },
+            [&](const auto& frame) {
+                LibraryInfo lib;
+                if (frame.type != FrameType::LibraryReady || !ProjectParser::decodeLibraryInfo(frame.payload, lib)) {
+                    return;
+                }
+                std::error_code ec;
+                uintmax_t bitcodeBytes = fs::file_size(lib.finalLLVMIR, ec);
+                libraries.push_back(lib);
+                libraryScheduler.addJob({"库分析(" + lib.name + ")", ec ? 0 : static_cast<uint64_t>(bitcodeBytes)});
+                SVFUtil::outs() << "库 " << lib.name << " 的bitcode已就绪，加入分析队列\n";
+            },
+            [&](size_t libIndex, int resultFd) {
                 // 子进程
+                const LibraryInfo& lib = libraries[libIndex];
                 SVFUtil::outs() << "开始分析库: " << lib.name << " (PID: " << getpid() << ")\n";
-                analyzeSingleLibrary(lib);
-                exit(0); // 子进程完成后退出
-            } 
-            else {
-                // 父进程，记录子进程PID
-                child_pids.push_back(pid);
-                SVFUtil::outs() << "启动库分析进程 " << pid << " 分析库 " << lib.name 
-                               << "，超时限制: " << LIBRARY_TIMEOUT_MINUTES << " 分钟\n";
-            }
-        }
+                TimeStats stats = analyzeSingleLibrary(lib, functionWidth);
+                ResultChannel::writeFrame(resultFd, FrameType::Metrics, stats.metrics.dump());
+            },
+            [&](size_t libIndex, const ReapedChild& child) {
+                if (!child.completed) {
+                    SVFUtil::errs() << "库 " << libraries[libIndex].name << " 分析超时，已终止\n";
+                }
+                // 超时或崩溃的库没有回传记录，仍记下名称与峰值内存
+                nlohmann::json record;
+                std::string output = child.output;
+                for (const auto& frame : ResultChannel::parseFrames(output)) {
+                    if (frame.type == FrameType::Metrics) {
+                        record = nlohmann::json::parse(frame.payload, nullptr, false);
+                    }
+                }
+                if (!record.is_object()) {
+                    record = {{"name", libraries[libIndex].name}, {"reported", false}};
+                }
+                record["timed_out"] = !child.completed;
+                // 父进程通过 wait4 得到的峰值RSS覆盖子进程的全部生命周期
+                double peakRssMb = static_cast<double>(child.maxRssKb) / 1024.0;
+                if (!record["peak_rss_mb"].is_number() || record["peak_rss_mb"].get<double>() < peakRssMb) {
+                    record["peak_rss_mb"] = peakRssMb;
+                }
+                libraryMetrics.push_back(record);
+            });
 
-        // 父进程等待所有子进程完成（带超时机制）
-        for (pid_t child_pid : child_pids) {
-            waitProcessWithTimeout(child_pid, LIBRARY_TIMEOUT_SECONDS, "库分析");
-        }
-        
-        // 在多进程模式下，需要从文件中读取各个库的统计信息
-        // 因为子进程的统计信息无法直接返回给父进程
-        SVFUtil::outs() << "多进程模式下，各库的详细时间统计请查看对应的 .timing.json 文件\n";
+        projectParsingTime = libraryScheduler.getSourceSeconds();
+        SVFUtil::outs() << "项目解析 耗时: " << std::fixed << std::setprecision(3) << projectParsingTime
+                        << " 秒（与库分析重叠进行）\n";
+        SVFUtil::outs() << "共发现 " << libraries.size() << " 个库需要分析\n";
     }
     
     double totalProgramTime = totalProgramTimer.elapsed();
@@ -552,6 +749,9 @@ int main(int argc, char ** argv)
         };
     }
     
+    // 各库与各函数的指标分布（分位数），两种模式下均可用
+    summaryJson["metrics"] = Metrics::summarize(libraryMetrics);
+    
     std::ofstream summaryOutFile(summaryFile);
     if (summaryOutFile.is_open()) {
         summaryOutFile << summaryJson.dump(4, ' ', false);
@@ -0,0 +1,117 @@
+#include "taintanalysis/AnalysisBudget.h"
+#include "config/EnvConfig.h"
+#include <chrono>
+
+namespace {
+    AnalysisBudget::Level& localLevel() {
+        thread_local AnalysisBudget::Level level = AnalysisBudget::Full;
+        return level;
+    }
+
+    AnalysisBudget::Level& localResultLevel() {
+        thread_local AnalysisBudget::Level level = AnalysisBudget::Full;
+        return level;
+    }
+
+    struct Deadline {
+        bool active = false;
+        bool reached = false;
+        std::chrono::steady_clock::time_point at;
+    };
+
+    Deadline& localDeadline() {
+        thread_local Deadline deadline;
+        return deadline;
+    }
+
+    size_t readDepth(const char* name, long defaultValue) {
+        long value = EnvConfig::getLong(name, defaultValue);
+        return value > 0 ? static_cast<size_t>(value) : 1;
+    }
+
+    // minimal 档位在 reduced 的基础上减半，至少为 1
+    size_t depthFor(AnalysisBudget::Level level, size_t reducedDepth) {
+        switch (level) {
+            case AnalysisBudget::Reduced:
+                return reducedDepth;
+            case AnalysisBudget::Minimal:
+                return reducedDepth > 1 ? reducedDepth / 2 : 1;
+            default:
+                return 0;
+        }
+    }
+}
+
+void AnalysisBudget::setLevel(unsigned level) {
+    localLevel() = level >= LEVEL_COUNT ? Minimal : static_cast<Level>(level);
+    localResultLevel() = localLevel();
+}
+
+void AnalysisBudget::noteLevel(Level used) {
+    if (used > localResultLevel()) {
+        localResultLevel() = used;
+    }
+}
+
+AnalysisBudget::Level AnalysisBudget::resultLevel() {
+    return localResultLevel();
+}
+
+int AnalysisBudget::timeoutFor(int baseSeconds, unsigned level) {
+    if (baseSeconds <= 0) {
+        return baseSeconds;   // 不限时
+    }
+    int timeout = baseSeconds;
+    for (unsigned i = 0; i < level && timeout > 1; i++) {
+        timeout /= 2;
+    }
+    return timeout < 1 ? 1 : timeout;
+}
+
+AnalysisBudget::Level AnalysisBudget::level() {
+    return localLevel();
+}
+
+const char* AnalysisBudget::levelName(Level level) {
+    switch (level) {
+        case Reduced:
+            return "reduced";
+        case Minimal:
+            return "minimal";
+        default:
+            return "full";
+    }
+}
+
+size_t AnalysisBudget::maxSliceDepth() {
+    static const size_t reducedDepth = readDepth("NAPI_SVF_DEGRADED_SLICE_DEPTH", 16);
+    return depthFor(level(), reducedDepth);
+}
+
+size_t AnalysisBudget::maxCalleeDepth() {
+    static const size_t reducedDepth = readDepth("NAPI_SVF_DEGRADED_CALLEE_DEPTH", 2);
+    return depthFor(level(), reducedDepth);
+}
+
+bool AnalysisBudget::aliasFallback() {
+    return level() != Minimal;
+}
+
+void AnalysisBudget::setDeadline(int seconds) {
+    Deadline& deadline = localDeadline();
+    deadline.active = seconds > 0;
+    deadline.reached = false;
+    deadline.at = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+}
+
+void AnalysisBudget::clearDeadline() {
+    localDeadline() = Deadline();
+}
+
+bool AnalysisBudget::expired() {
+    Deadline& deadline = localDeadline();
+    if (deadline.active && !deadline.reached && std::chrono::steady_clock::now() >= deadline.at) {
+        deadline.reached = true;
+    }
+    return deadline.reached;
+}
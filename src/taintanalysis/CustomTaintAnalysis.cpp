@@ -4,6 +4,7 @@
 #include "WPA/Andersen.h"
 #include "SVF-LLVM/SVFIRBuilder.h"
 #include "Util/Options.h"
+#include "scheduler/TaskOutput.h"
 
 
 using namespace SVF;
@@ -106,7 +107,7 @@ std::vector<SVF::NodeID> CustomTaintAnalysis::handleNapiGetCbInfo(const llvm::Ca
         // 调试输出原始值信息
         SVFUtil::outs() << "Tracing arraydecay source for: ";
         // 打印llvmVal
-        llvmVal->print(llvm::outs(),true);
+        llvmVal->print(TaskOutput::outs(),true);
         SVFUtil::outs() << "\n";
 
         
@@ -115,14 +116,14 @@ std::vector<SVF::NodeID> CustomTaintAnalysis::handleNapiGetCbInfo(const llvm::Ca
             // 获取被操作数
             const llvm::Value* basePointer = gep->getPointerOperand();
             SVFUtil::outs() << "Found GEP base pointer: ";
-            basePointer->print(llvm::outs(),true);
+            basePointer->print(TaskOutput::outs(),true);
             SVFUtil::outs() << "\n";
            
             
             // 查找alloca指令（原始数组分配）
             if (const llvm::AllocaInst* alloca = llvm::dyn_cast<llvm::AllocaInst>(basePointer)) {
                 SVFUtil::outs() << "Found original array allocation: ";
-                alloca->print(llvm::outs(),true);
+                alloca->print(TaskOutput::outs(),true);
                 SVFUtil::outs() << "\n";
                 
                 // 获取alloca指令对应的SVF节点ID
@@ -340,7 +341,7 @@ void CustomTaintAnalysis::processStackObj(const SVF::StackObjVar* stackObj, cons
             if (const SVF::PAGNode* node = pag->getGNode(elemNode)) {
                 if (const llvm::Value* val = LLVMModuleSet::getLLVMModuleSet()->getLLVMValue(node)) {
                     SVFUtil::outs() << "  Value: ";
-                    val->print(llvm::outs());
+                    val->print(TaskOutput::outs());
                     SVFUtil::outs() << "\n";
                 }
             }
@@ -0,0 +1,125 @@
+#include "taintanalysis/SummaryCodec.h"
+#include <cstdint>
+
+namespace {
+    void putU32(std::string& out, uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+    }
+
+    void putString(std::string& out, const std::string& value) {
+        putU32(out, static_cast<uint32_t>(value.size()));
+        out.append(value);
+    }
+
+    void putStrings(std::string& out, const std::vector<std::string>& values) {
+        putU32(out, static_cast<uint32_t>(values.size()));
+        for (const auto& value : values) {
+            putString(out, value);
+        }
+    }
+
+    // 顺序读取器，越界时置 ok = false 并返回空值
+    struct Reader {
+        const char* data;
+        size_t size;
+        size_t pos;
+        bool ok;
+
+        uint32_t getU32() {
+            if (!ok || size - pos < 4) {
+                ok = false;
+                return 0;
+            }
+            uint32_t value = 0;
+            for (int i = 0; i < 4; i++) {
+                value |= static_cast<uint32_t>(static_cast<unsigned char>(data[pos + i])) << (8 * i);
+            }
+            pos += 4;
+            return value;
+        }
+
+        std::string getString() {
+            uint32_t len = getU32();
+            if (!ok || size - pos < len) {
+                ok = false;
+                return std::string();
+            }
+            std::string value(data + pos, len);
+            pos += len;
+            return value;
+        }
+    };
+}
+
+void SummaryCodec::encode(const FunctionSummary& summary, std::string& out) {
+    putString(out, summary.name);
+
+    putU32(out, static_cast<uint32_t>(summary.params.size()));
+    for (const auto& param : summary.params) {
+        putString(out, param.first);
+        putString(out, param.second);
+    }
+
+    putU32(out, static_cast<uint32_t>(summary.items.size()));
+    for (const auto& item : summary.items) {
+        putString(out, item.getFunctionName());
+        putString(out, item.getInstructionType());
+
+        std::vector<std::pair<std::string, int>> retValues = item.getRetValues();
+        putU32(out, static_cast<uint32_t>(retValues.size()));
+        for (const auto& [node, value] : retValues) {
+            putString(out, node);
+            putU32(out, static_cast<uint32_t>(value));
+        }
+
+        putStrings(out, item.getOperands());
+        putStrings(out, item.getArgsOperands());
+    }
+
+    putString(out, summary.budget);
+}
+
+bool SummaryCodec::decode(const char* data, size_t size, FunctionSummary& summary) {
+    Reader reader{data, size, 0, true};
+
+    summary.name = reader.getString();
+
+    uint32_t paramCount = reader.getU32();
+    for (uint32_t i = 0; i < paramCount && reader.ok; i++) {
+        std::string key = reader.getString();
+        std::string paramName = reader.getString();
+        summary.params.emplace_back(key, paramName);
+    }
+
+    uint32_t itemCount = reader.getU32();
+    for (uint32_t i = 0; i < itemCount && reader.ok; i++) {
+        std::string funcName = reader.getString();
+        std::string instType = reader.getString();
+        SummaryItem item(funcName, instType);
+
+        uint32_t retCount = reader.getU32();
+        for (uint32_t j = 0; j < retCount && reader.ok; j++) {
+            std::string node = reader.getString();
+            int value = static_cast<int>(reader.getU32());
+            item.addRetValue(node, value);
+        }
+
+        uint32_t operandCount = reader.getU32();
+        for (uint32_t j = 0; j < operandCount && reader.ok; j++) {
+            item.addOperand(reader.getString());
+        }
+
+        uint32_t argsCount = reader.getU32();
+        for (uint32_t j = 0; j < argsCount && reader.ok; j++) {
+            item.addArgsOperand(reader.getString());
+        }
+
+        summary.items.push_back(item);
+    }
+
+    summary.budget = reader.getString();
+
+    return reader.ok && reader.pos == size;
+}
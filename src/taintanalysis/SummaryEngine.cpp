@@ -0,0 +1,362 @@
+#include "taintanalysis/SummaryEngine.h"
+#include "napi/NapiHandler.h"
+#include "napi/NapiCallSiteIndex.h"
+#include "napi/utils/SliceCache.h"
+#include "taintanalysis/AnalysisBudget.h"
+#include "config/EnvConfig.h"
+#include "scheduler/TaskOutput.h"
+#include "scheduler/ThreadPool.h"
+#include "SVF-LLVM/LLVMUtil.h"
+#include "SVF-LLVM/LLVMModule.h"
+#include <algorithm>
+#include <unordered_set>
+
+using namespace SVF;
+using namespace llvm;
+
+namespace {
+    // "%n" 形式的编号按映射表替换，其余操作数（top、常量等）原样保留
+    std::string renameOperand(const std::string& operand, const std::vector<int>& mapping) {
+        if (operand.size() < 2 || operand[0] != '%') {
+            return operand;
+        }
+        size_t id = 0;
+        for (size_t i = 1; i < operand.size(); i++) {
+            if (operand[i] < '0' || operand[i] > '9') {
+                return operand;
+            }
+            id = id * 10 + static_cast<size_t>(operand[i] - '0');
+        }
+        if (id >= mapping.size()) {
+            return operand;
+        }
+        return "%" + std::to_string(mapping[id]);
+    }
+
+    SummaryItem renameItem(const SummaryItem& item, const std::vector<int>& mapping) {
+        SummaryItem renamed(item.getFunctionName(), item.getInstructionType());
+        for (const std::string& operand : item.getOperands()) {
+            renamed.addOperand(renameOperand(operand, mapping));
+        }
+        for (const std::string& operand : item.getArgsOperands()) {
+            renamed.addArgsOperand(renameOperand(operand, mapping));
+        }
+        for (const auto& retValue : item.getRetValues()) {
+            renamed.addRetValue(renameOperand(retValue.first, mapping), retValue.second);
+        }
+        return renamed;
+    }
+
+    // 调用点的实参在调用者中的编号：已有编号直接使用，否则按别名关系查找，仍找不到时分配新编号
+    int bindActual(NodeID node, TaintMap& taintMap, AndersenBase* ander) {
+        if (!taintMap.getNewIds(node).empty()) {
+            return taintMap.getNewIds(node)[0];
+        }
+        std::vector<NodeID> probe = {node};
+        taintMap.getExistingNodes(probe, ander);
+        if (!taintMap.getNewIds(node).empty()) {
+            return taintMap.getNewIds(node)[0];
+        }
+        return taintMap.assignNewId(node);
+    }
+}
+
+SummaryEngine::SummaryEngine(SVFIR* pag, AndersenBase* ander, SVFG* svfg) : pag(pag), ander(ander), svfg(svfg) {}
+
+bool SummaryEngine::isEnabled() {
+    return EnvConfig::getString("NAPI_SVF_SUMMARY_MODE", "inline") == "compositional";
+}
+
+const Function* SummaryEngine::resolveCallee(const CallBase* callSite) {
+    return NapiCallSiteIndex::resolveCallee(callSite);
+}
+
+const CalleeSummary* SummaryEngine::lookup(const Function* func) const {
+    auto it = slotOf.find(func);
+    if (it == slotOf.end() || !slotReady[it->second]) {
+        return nullptr;
+    }
+    return &slots[it->second];
+}
+
+MetricCounters SummaryEngine::build(const std::vector<const Function*>& roots, size_t width, int timeoutSeconds) {
+    // 迭代式 Tarjan 算法求调用图的强连通分量，分量的完成顺序即自底向上的顺序
+    std::unordered_map<const Function*, unsigned> index;
+    std::unordered_map<const Function*, unsigned> lowlink;
+    std::unordered_set<const Function*> onStack;
+    std::unordered_set<const Function*> called;   // 至少被一个调用点调用的函数，只有它们需要摘要
+    std::vector<const Function*> sccStack;
+    std::vector<std::vector<const Function*>> sccs;
+    std::unordered_map<const Function*, std::vector<const Function*>> calleesOf;
+    unsigned nextIndex = 0;
+
+    struct DfsFrame {
+        const Function* func;
+        std::vector<const Function*> callees;
+        size_t nextCallee;
+    };
+    std::vector<DfsFrame> dfs;
+    const NapiCallSiteIndex& callSiteIndex = NapiCallSiteIndex::getInstance();
+
+    auto enter = [&](const Function* func) {
+        index[func] = lowlink[func] = nextIndex++;
+        sccStack.push_back(func);
+        onStack.insert(func);
+        DfsFrame frame{func, {}, 0};
+        for (const CallBase* callSite : callSiteIndex.callSitesIn(func)) {
+            const Function* callee = resolveCallee(callSite);
+            if (!callee->isDeclaration()) {
+                frame.callees.push_back(callee);
+                called.insert(callee);
+            }
+        }
+        calleesOf[func] = frame.callees;
+        dfs.push_back(std::move(frame));
+    };
+
+    for (const Function* root : roots) {
+        if (!root || root->isDeclaration() || index.count(root)) {
+            continue;
+        }
+        enter(root);
+        while (!dfs.empty()) {
+            DfsFrame& top = dfs.back();
+            if (top.nextCallee < top.callees.size()) {
+                const Function* callee = top.callees[top.nextCallee++];
+                const Function* caller = top.func;
+                if (!index.count(callee)) {
+                    enter(callee);   // 之后 top 可能失效
+                } else if (onStack.count(callee)) {
+                    lowlink[caller] = std::min(lowlink[caller], index[callee]);
+                }
+                continue;
+            }
+
+            const Function* func = top.func;
+            if (lowlink[func] == index[func]) {
+                std::vector<const Function*> scc;
+                const Function* member = nullptr;
+                do {
+                    member = sccStack.back();
+                    sccStack.pop_back();
+                    onStack.erase(member);
+                    scc.push_back(member);
+                } while (member != func);
+                sccs.push_back(std::move(scc));
+            }
+            dfs.pop_back();
+            if (!dfs.empty()) {
+                const Function* caller = dfs.back().func;
+                lowlink[caller] = std::min(lowlink[caller], lowlink[func]);
+            }
+        }
+    }
+
+    // 同一分量内按函数名排序，递归调用中尚未完成的成员在调用点被跳过，结果与遍历顺序无关；
+    // 槽位按分量的完成顺序（自底向上）预先分配
+    std::unordered_map<const Function*, size_t> sccOf;
+    std::vector<std::vector<size_t>> sccSlots(sccs.size());
+    for (size_t sccIndex = 0; sccIndex < sccs.size(); sccIndex++) {
+        auto& scc = sccs[sccIndex];
+        std::sort(scc.begin(), scc.end(), [](const Function* a, const Function* b) {
+            return a->getName() < b->getName();
+        });
+        for (const Function* func : scc) {
+            sccOf[func] = sccIndex;
+            if (called.count(func)) {
+                slotOf[func] = slots.size();
+                sccSlots[sccIndex].push_back(slots.size());
+                slots.emplace_back();
+            }
+        }
+    }
+    slotReady.assign(slots.size(), 0);
+
+    // 分量之间的依赖：调用者所在分量依赖被调者所在分量
+    std::vector<std::vector<size_t>> dependents(sccs.size());
+    std::vector<size_t> dependencyCounts(sccs.size(), 0);
+    for (size_t sccIndex = 0; sccIndex < sccs.size(); sccIndex++) {
+        std::unordered_set<size_t> calleeSccs;
+        for (const Function* func : sccs[sccIndex]) {
+            for (const Function* callee : calleesOf[func]) {
+                size_t calleeScc = sccOf[callee];
+                if (calleeScc != sccIndex && calleeSccs.insert(calleeScc).second) {
+                    dependents[calleeScc].push_back(sccIndex);
+                    dependencyCounts[sccIndex]++;
+                }
+            }
+        }
+    }
+
+    std::vector<const Function*> slotFunctions(slots.size());
+    for (const auto& entry : slotOf) {
+        slotFunctions[entry.second] = entry.first;
+    }
+    if (width == 0) {
+        width = 1;
+    }
+    std::vector<MetricCounters> workerCounters(width);
+    std::vector<size_t> workerDegraded(width, 0);
+    std::vector<size_t> workerTimedOut(width, 0);
+    ThreadPool::runDag(width, dependents, dependencyCounts, [&](size_t workerIndex, size_t sccIndex) {
+        TaskOutput::Scope output;   // 每个强连通分量的输出整块写出
+        MetricCounters before = Metrics::local();
+        bool finished = false;
+        for (unsigned attempt = 0; attempt < AnalysisBudget::LEVEL_COUNT && !finished; attempt++) {
+            AnalysisBudget::setLevel(attempt);
+            AnalysisBudget::setDeadline(AnalysisBudget::timeoutFor(timeoutSeconds, attempt));
+            for (size_t slot : sccSlots[sccIndex]) {
+                slots[slot] = summarize(slotFunctions[slot]);
+            }
+            finished = !AnalysisBudget::expired();
+        }
+        if (!finished) {
+            // 各档位均超时：摘要置空，依赖它的导出函数按降级结果处理
+            for (size_t slot : sccSlots[sccIndex]) {
+                slots[slot] = CalleeSummary();
+                slots[slot].level = AnalysisBudget::Minimal;
+            }
+            workerTimedOut[workerIndex] += sccSlots[sccIndex].size();
+        } else if (AnalysisBudget::level() != AnalysisBudget::Full) {
+            workerDegraded[workerIndex] += sccSlots[sccIndex].size();
+        }
+        for (size_t slot : sccSlots[sccIndex]) {
+            slotReady[slot] = 1;
+        }
+        AnalysisBudget::clearDeadline();
+        AnalysisBudget::setLevel(AnalysisBudget::Full);
+        workerCounters[workerIndex] += Metrics::local() - before;
+    });
+
+    MetricCounters total;
+    size_t nonEmpty = 0;
+    size_t degraded = 0;
+    size_t timedOut = 0;
+    for (size_t i = 0; i < width; i++) {
+        total += workerCounters[i];
+        degraded += workerDegraded[i];
+        timedOut += workerTimedOut[i];
+    }
+    for (const CalleeSummary& summary : slots) {
+        if (!summary.isEmpty()) {
+            nonEmpty++;
+        }
+    }
+    SVFUtil::outs() << "组合式摘要: 调用图共 " << sccs.size() << " 个强连通分量，" << width << " 个线程计算了 "
+                    << slots.size() << " 个内部函数的摘要，其中 " << nonEmpty << " 个非空，" << degraded
+                    << " 个以降低的预算档位得出，" << timedOut << " 个在各档位均超时\n";
+    return total;
+}
+
+CalleeSummary SummaryEngine::summarize(const Function* func) const {
+    // 以被调函数自身的形参为起点，与导出函数的分析方式相同
+    std::vector<std::pair<NodeID, std::string>> paramNodeIDs;
+    for (const Argument& arg : func->args()) {
+        NodeID argNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(&arg);
+        paramNodeIDs.emplace_back(argNodeID, arg.getName().str());
+    }
+    TaintMap taintMap(paramNodeIDs, ander);
+    taintMap.reserveRootParamIds();
+    SliceCache::reset();
+
+    CalleeSummary summary;
+    processCallSites(func, taintMap, summary.items, nullptr);
+    if (summary.isEmpty()) {
+        summary.level = AnalysisBudget::resultLevel();
+        return summary;
+    }
+
+    for (const ParamInfo& paramInfo : taintMap.getParamIds()) {
+        summary.paramIds.push_back(paramInfo.paramId);
+    }
+    summary.level = AnalysisBudget::resultLevel();
+    summary.envId = taintMap.getEnvId();
+    summary.callbackInfoId = taintMap.getCallbackInfoId();
+    summary.idCount = taintMap.getIdCount();
+    summary.nodeBindings.assign(taintMap.getNodeBindings().begin(), taintMap.getNodeBindings().end());
+    std::sort(summary.nodeBindings.begin(), summary.nodeBindings.end());
+    summary.valueFlows.assign(taintMap.getValueFlows().begin(), taintMap.getValueFlows().end());
+    std::sort(summary.valueFlows.begin(), summary.valueFlows.end());
+    return summary;
+}
+
+void SummaryEngine::processCallSites(const Function* func, TaintMap& taintMap, std::vector<SummaryItem>& summaryItems,
+                                     std::vector<const Instruction*>* callSites) const {
+    for (const CallBase* callSite : NapiCallSiteIndex::getInstance().callSitesIn(func)) {
+        // 截止时间已到时不再处理剩余的调用点
+        if (AnalysisBudget::expired()) {
+            break;
+        }
+        const Function* callee = resolveCallee(callSite);
+        if (callSites) {
+            callSites->push_back(callSite);
+        }
+        if (SVFUtil::isa<CallInst>(callSite)) {
+            NapiHandler::getInstance().dispatch(callSite, taintMap, svfg, pag, ander, summaryItems);
+        }
+        const CalleeSummary* calleeSummary = lookup(callee);
+        if (calleeSummary) {
+            AnalysisBudget::noteLevel(calleeSummary->level);
+        }
+        if (calleeSummary && !calleeSummary->isEmpty()) {
+            instantiate(*calleeSummary, callSite, taintMap, summaryItems);
+        }
+    }
+}
+
+void SummaryEngine::instantiate(const CalleeSummary& summary, const CallBase* callSite, TaintMap& taintMap,
+                                std::vector<SummaryItem>& summaryItems) const {
+    std::vector<int> mapping(summary.idCount, -1);
+
+    // env 与 cbinfo 沿调用链传递，最终都是导出函数的前两个参数
+    auto mapRootParam = [&](int calleeId, int callerId) {
+        if (calleeId >= 0 && calleeId < summary.idCount && callerId >= 0) {
+            mapping[calleeId] = callerId;
+        }
+    };
+    mapRootParam(summary.envId, taintMap.getEnvId());
+    mapRootParam(summary.callbackInfoId, taintMap.getCallbackInfoId());
+
+    // 形参编号映射为实参在调用者中的编号
+    for (size_t i = 0; i < summary.paramIds.size() && i < callSite->arg_size(); i++) {
+        int calleeId = summary.paramIds[i];
+        if (calleeId < 0 || calleeId >= summary.idCount || mapping[calleeId] != -1) {
+            continue;
+        }
+        const Value* actual = callSite->getArgOperand(i);
+        if (SVFUtil::isa<Constant>(actual)) {
+            continue;
+        }
+        NodeID actualNodeID = LLVMModuleSet::getLLVMModuleSet()->getValueNode(actual);
+        if (actualNodeID != 0) {
+            mapping[calleeId] = bindActual(actualNodeID, taintMap, ander);
+        }
+    }
+    // 其余编号在调用者中按顺序重新分配
+    for (int& mapped : mapping) {
+        if (mapped == -1) {
+            mapped = taintMap.allocateId();
+        }
+    }
+
+    for (const auto& binding : summary.nodeBindings) {
+        std::vector<int> renamed;
+        for (int id : binding.second) {
+            renamed.push_back(id >= 0 && id < summary.idCount ? mapping[id] : id);
+        }
+        taintMap.bindIfAbsent(binding.first, renamed);
+    }
+    for (const auto& flow : summary.valueFlows) {
+        if (flow.first < 0 || flow.first >= summary.idCount) {
+            continue;
+        }
+        for (int source : flow.second) {
+            if (source >= 0 && source < summary.idCount) {
+                taintMap.addValueFlowSource(mapping[flow.first], mapping[source]);
+            }
+        }
+    }
+    for (const SummaryItem& item : summary.items) {
+        summaryItems.push_back(renameItem(item, mapping));
+    }
+}
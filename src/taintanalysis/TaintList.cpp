@@ -5,15 +5,16 @@
 #include "SVF-LLVM/SVFIRBuilder.h"
 #include "Util/Options.h"
 #include "SourceAndSinks/SourceAndSinks.h"
+#include "metrics/Metrics.h"
 
 using namespace llvm;
 using namespace SVF;
 
-TaintList::TaintList(SVF::Andersen* ander, const std::vector<TaintUnit>& taintUnits)
+TaintList::TaintList(SVF::AndersenBase* ander, const std::vector<TaintUnit>& taintUnits)
     : ander(ander), originalTargetUnits(taintUnits) { 
 }
 
-TaintList::TaintList(SVF::Andersen* ander, const std::vector<TaintUnit>& taintUnits, std::string function_Name, std::vector<SVF::NodeID> function_ParamNodeIDs)
+TaintList::TaintList(SVF::AndersenBase* ander, const std::vector<TaintUnit>& taintUnits, std::string function_Name, std::vector<SVF::NodeID> function_ParamNodeIDs)
     : ander(ander), originalTargetUnits(taintUnits), function_Name(function_Name), function_ParamNodeIDs(function_ParamNodeIDs) {
 }
 
@@ -225,6 +226,7 @@ unsigned int TaintList::findOrCreateMapping(SVF::NodeID originalID, unsigned int
 }
 
 bool TaintList::isAlias(SVF::NodeID id1, SVF::NodeID id2) const {
+    Metrics::countAliasQuery();
     return ander->alias(id1, id2) == SVF::AliasResult::MayAlias;
 }
 
@@ -1,10 +1,15 @@
 #include "taintanalysis/TaintMap.h"
+#include "metrics/Metrics.h"
+#include "taintanalysis/AnalysisBudget.h"
+#include <algorithm>
+#include <unordered_set>
 
 using namespace SVF;
 
-TaintMap::TaintMap() : counter(0) {}
+TaintMap::TaintMap() : counter(0), pta(nullptr), envId(-1), callbackInfoId(-1) {}
 
-TaintMap::TaintMap(std::vector<std::pair<NodeID, std::string>> paramNodeIDs, SVF::PointerAnalysis* pta) : counter(0), pta(pta) {
+TaintMap::TaintMap(std::vector<std::pair<NodeID, std::string>> paramNodeIDs, SVF::PointerAnalysis* pta)
+    : counter(0), pta(pta), envId(-1), callbackInfoId(-1) {
     this->pta = pta; // 初始化PointerAnalysis指针
     for (size_t i = 0; i < paramNodeIDs.size(); ++i) {
         const auto& node = paramNodeIDs[i];
@@ -22,6 +27,13 @@ TaintMap::TaintMap(std::vector<std::pair<NodeID, std::string>> paramNodeIDs, SVF
         
         paramIds.push_back(ParamInfo(node.first, paramId, paramName));
     }
+    envId = getParamIdByIndex(0);
+    callbackInfoId = getParamIdByIndex(1);
+}
+
+void TaintMap::reserveRootParamIds() {
+    envId = allocateId();
+    callbackInfoId = allocateId();
 }
 
 int TaintMap::assignNewId(NodeID node) {
@@ -34,10 +46,7 @@ int TaintMap::assignNewId(NodeID node) {
     }
 
     int newId = counter++;
-    if (nodeToNewIds.find(node) == nodeToNewIds.end()) {
-        nodeToNewIds[node] = std::vector<int>();
-    }
-    nodeToNewIds[node].push_back(newId);
+    entryFor(node).push_back(newId);
     if (newIdToNode.find(newId) == newIdToNode.end()) {
         newIdToNode[newId] = std::vector<SVF::NodeID>();
     }
@@ -49,8 +58,7 @@ int TaintMap::assignNewId(NodeID node) {
         NodeID objId = *it;
         if (nodeToNewIds.find(objId) == nodeToNewIds.end()) {
             int objNewId = newId;
-            nodeToNewIds[objId] = std::vector<int>();
-            nodeToNewIds[objId].push_back(objNewId);
+            entryFor(objId).push_back(objNewId);
             if (newIdToNode.find(objNewId) == newIdToNode.end()) {
                 newIdToNode[objNewId] = std::vector<SVF::NodeID>();
             }
@@ -70,12 +78,12 @@ std::vector<int> TaintMap::assignArrayNewIds(NodeID arrayNode, int elementCount)
         }
         newIdToNode[newIds.back()].push_back(arrayNode);
     }
-    nodeToNewIds[arrayNode] = newIds;
+    entryFor(arrayNode) = newIds;
     return newIds;
 }
 
 void TaintMap::setArrayNewIds(NodeID arrayNode, const std::vector<int>& newIds) {
-    nodeToNewIds[arrayNode] = newIds;
+    entryFor(arrayNode) = newIds;
 }
 
 void TaintMap::recordValueFlow(int dest, const std::vector<int>& sources) {
@@ -89,10 +97,7 @@ const std::vector<int>& TaintMap::getNewIds(NodeID node) const {
 }
 
 void TaintMap::setNewID(NodeID node, int newId) {
-    if (nodeToNewIds.find(node) == nodeToNewIds.end()) {
-        nodeToNewIds[node] = std::vector<int>();
-    }
-    nodeToNewIds[node].push_back(newId);
+    entryFor(node).push_back(newId);
     if (newIdToNode.find(newId) == newIdToNode.end()) {
         newIdToNode[newId] = std::vector<SVF::NodeID>();
     }
@@ -100,10 +105,8 @@ void TaintMap::setNewID(NodeID node, int newId) {
 }
 
 void TaintMap::setNewIDAtFront(NodeID node, int newId) {
-    if (nodeToNewIds.find(node) == nodeToNewIds.end()) {
-        nodeToNewIds[node] = std::vector<int>();
-    }
-    nodeToNewIds[node].insert(nodeToNewIds[node].begin(), newId);
+    std::vector<int>& newIds = entryFor(node);
+    newIds.insert(newIds.begin(), newId);
     if (newIdToNode.find(newId) == newIdToNode.end()) {
         newIdToNode[newId] = std::vector<SVF::NodeID>();
     }
@@ -129,7 +132,7 @@ void TaintMap::addValueFlowSource(int dest, int source) {
     valueFlowMap[dest].push_back(source);
 }
 
-std::vector<SVF::NodeID> TaintMap::getExistingNodes(std::vector<SVF::NodeID>& nodes, SVF::Andersen* ander) {
+std::vector<SVF::NodeID> TaintMap::getExistingNodes(std::vector<SVF::NodeID>& nodes, SVF::AndersenBase* ander) {
     std::vector<SVF::NodeID> result;
     for (SVF::NodeID node : nodes) {
         bool shouldAdd = false;
@@ -138,16 +141,12 @@ std::vector<SVF::NodeID> TaintMap::getExistingNodes(std::vector<SVF::NodeID>& no
         // 检查节点是否直接存在于nodeToNewIds中
         if (nodeToNewIds.find(node) != nodeToNewIds.end()) {
             shouldAdd = true;
-        } else {
-            // 对每个node与nodeToNewIds中的所有节点进行aliasQuery检查
-            for (const auto& existingNode : nodeToNewIds) {
-                SVF::NodeID existingNodeId = existingNode.first;
-                if (ander->alias(node, existingNodeId) == SVF::AliasResult::MayAlias ||
-                    ander->alias(node, existingNodeId) == SVF::AliasResult::MustAlias) {
-                    shouldAdd = true;
-                    aliasNodeId = existingNodeId; // 记录找到的别名节点
-                    break;
-                }
+        } else if (AnalysisBudget::aliasFallback()) {
+            // 通过对象反向索引查找与node可能别名的表项，取最早加入的一个（最低预算档位不做别名回退）
+            std::vector<SVF::NodeID> aliasKeys = findAliasKeys(node);
+            if (!aliasKeys.empty()) {
+                shouldAdd = true;
+                aliasNodeId = aliasKeys.front(); // 记录找到的别名节点
             }
         }
         
@@ -156,9 +155,9 @@ std::vector<SVF::NodeID> TaintMap::getExistingNodes(std::vector<SVF::NodeID>& no
             result.push_back(node);  
             // 如果节点是通过别名关系发现的，且不在nodeToNewIds中，则将其添加到映射中
             if (nodeToNewIds.find(node) == nodeToNewIds.end() && aliasNodeId != 0) {
-                // 复制别名节点的所有新ID到当前节点
-                const std::vector<int>& aliasNewIds = nodeToNewIds[aliasNodeId];
-                nodeToNewIds[node] = aliasNewIds;
+                // 复制别名节点的所有新ID到当前节点（先复制，插入新表项可能使引用失效）
+                std::vector<int> aliasNewIds = nodeToNewIds[aliasNodeId];
+                entryFor(node) = aliasNewIds;
                 
                 // 同时更新newIdToNode映射
                 for (int newId : aliasNewIds) {
@@ -180,14 +179,96 @@ int TaintMap::getParamIdByIndex(size_t index) const {
     return -1; // 索引超出范围
 }
 
-int TaintMap::getParamIdIfAlias(SVF::NodeID nodeID, SVF::Andersen* ander) const {
+int TaintMap::getParamIdIfAlias(SVF::NodeID nodeID, SVF::AndersenBase* ander) const {
+    // 参数节点均是表项，与查找普通表项共用对象反向索引，按参数顺序返回第一个别名参数
+    std::vector<SVF::NodeID> aliasKeys = findAliasKeys(nodeID);
+    if (aliasKeys.empty()) {
+        return -1;
+    }
+    std::unordered_set<SVF::NodeID> aliasKeySet(aliasKeys.begin(), aliasKeys.end());
     for (const auto& paramInfo : paramIds) {
-        // 检查是否可能是别名
-        if (ander->alias(nodeID, paramInfo.nodeId) == SVF::AliasResult::MayAlias ||
-            ander->alias(nodeID, paramInfo.nodeId) == SVF::AliasResult::MustAlias) {
+        if (aliasKeySet.count(paramInfo.nodeId)) {
             return paramInfo.paramId;
         }
     }
     return -1; // 没有找到别名关系
 }
 
+int TaintMap::allocateId() {
+    return counter++;
+}
+
+void TaintMap::bindIfAbsent(NodeID node, const std::vector<int>& newIds) {
+    if (newIds.empty() || nodeToNewIds.find(node) != nodeToNewIds.end()) {
+        return;
+    }
+    entryFor(node) = newIds;
+    for (int newId : newIds) {
+        newIdToNode[newId].push_back(node);
+    }
+}
+
+std::vector<int>& TaintMap::entryFor(NodeID node) {
+    auto it = nodeToNewIds.find(node);
+    if (it != nodeToNewIds.end()) {
+        return it->second;
+    }
+    std::vector<int>& newIds = nodeToNewIds[node];
+    // 新表项按其指向集（展开域不敏感对象后，与 Andersen 的别名判断一致）登记到反向索引
+    keyOrder[node] = keyOrder.size();
+    if (pta) {
+        PointsTo expanded = expandedPts(node);
+        if (pta->containBlackHoleNode(expanded)) {
+            blackHoleKeys.push_back(node);
+        }
+        for (NodeID objId : expanded) {
+            objectToKeys[objId].push_back(node);
+        }
+    }
+    return newIds;
+}
+
+PointsTo TaintMap::expandedPts(NodeID node) const {
+    PointsTo expanded;
+    pta->expandFIObjs(pta->getPts(node), expanded);
+    return expanded;
+}
+
+std::vector<NodeID> TaintMap::findAliasKeys(NodeID node) const {
+    std::vector<NodeID> keys;
+    if (!pta || nodeToNewIds.empty()) {
+        return keys;
+    }
+    Metrics::countAliasQuery();
+
+    // 与 Andersen 的判断一致：任一方指向集含黑洞节点，或两者指向集相交，即为可能别名
+    PointsTo expanded = expandedPts(node);
+    if (pta->containBlackHoleNode(expanded)) {
+        for (const auto& entry : nodeToNewIds) {
+            keys.push_back(entry.first);
+        }
+    } else {
+        std::unordered_set<NodeID> seen;
+        for (NodeID objId : expanded) {
+            auto it = objectToKeys.find(objId);
+            if (it == objectToKeys.end()) {
+                continue;
+            }
+            for (NodeID key : it->second) {
+                if (seen.insert(key).second) {
+                    keys.push_back(key);
+                }
+            }
+        }
+        for (NodeID key : blackHoleKeys) {
+            if (seen.insert(key).second) {
+                keys.push_back(key);
+            }
+        }
+    }
+    // 按表项加入的先后排序，结果与哈希表的遍历顺序无关
+    std::sort(keys.begin(), keys.end(), [this](NodeID a, NodeID b) {
+        return keyOrder.at(a) < keyOrder.at(b);
+    });
+    return keys;
+}
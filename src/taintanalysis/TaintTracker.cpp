@@ -11,12 +11,41 @@
 #include "taintanalysis/SummaryItem.h"
 #include "napi/utils/ParseVFG.h"
 #include "JsonExporter/SummaryExporter.h"
+#include "metrics/Metrics.h"
+#include "taintanalysis/SummaryEngine.h"
+#include "core/AnalysisContext.h"
+#include "napi/utils/SliceCache.h"
+#include "taintanalysis/AnalysisBudget.h"
+#include "scheduler/TaskOutput.h"
 using namespace SVF;
 using namespace llvm;
 
 // 正确实现构造函数（使用作用域解析运算符）
-TaintTracker::TaintTracker(SVF::PAG* pag, SVF::Andersen* ander, SVF::SVFG* svfg, SVF::VFG* vfg) 
-    : pag(pag), ander(ander), svfg(svfg), vfg(vfg) {
+TaintTracker::TaintTracker(AnalysisContext& context)
+    : pag(context.getPAG()), ander(context.getPointerAnalysis()), svfg(context.getSVFG()), context(&context),
+      verbose(true), summaryEngine(nullptr) {
+}
+
+VFG* TaintTracker::getVFG() {
+    return context->getVFG();
+}
+
+void TaintTracker::prepareForConcurrentQueries(SVF::PAG* pag, SVF::AndersenBase* ander) {
+    // getPts 与 getAllFieldsObjVars 在表项不存在时会插入默认值，
+    // 并发查询前为所有节点预先生成，避免多个线程同时修改底层 map
+    for (auto it = pag->begin(); it != pag->end(); ++it) {
+        NodeID id = it->first;
+        ander->getPts(id);
+        if (SVFUtil::isa<ObjVar>(it->second)) {
+            pag->getAllFieldsObjVars(id);
+        }
+    }
+    // LLVM 的函数参数是惰性构建的，提前构建以免遍历 args() 时写入 Function
+    for (const Module& module : LLVMModuleSet::getLLVMModuleSet()->getLLVMModules()) {
+        for (const Function& function : module) {
+            function.arg_begin();
+        }
+    }
 }
 
 bool TaintTracker::isTainted(SVF::NodeID id) const{
@@ -198,19 +227,24 @@ TaintUnit TaintTracker::handleReturnInstruction(const llvm::Instruction* inst) {
 
 
 
-std::vector<const Function *> TaintTracker::getCalledFunctions(const Function *F, std::set<const Function*>& visited)
+std::vector<const Function *> TaintTracker::getCalledFunctions(const Function *F, std::set<const Function*>& visited,
+                                                              std::vector<const Instruction*>& callSites, size_t depth)
 {
     std::vector<const Function *> calledFunctions;
     if (visited.count(F)) {
         return calledFunctions; // 已处理过，避免循环
     }
     visited.insert(F);
+    // 降级重试时只展开到限定深度的被调函数
+    const size_t maxDepth = AnalysisBudget::maxCalleeDepth();
+    const bool expandCallees = maxDepth == 0 || depth + 1 < maxDepth;
 
-    
     for (const Instruction &I : instructions(F))
     {
-        I.print(llvm::outs());
-        SVFUtil::outs() << "\n";
+        if (verbose) {
+            I.print(TaskOutput::outs());
+            SVFUtil::outs() << "\n";
+        }
         if (const CallBase *callInst = SVFUtil::dyn_cast<CallBase>(&I))
         {
             const Function *calledFunction = callInst->getCalledFunction();
@@ -223,8 +257,11 @@ std::vector<const Function *> TaintTracker::getCalledFunctions(const Function *F
             if (calledFunction)
             {
                 calledFunctions.push_back(calledFunction);
-                targetedinst.push_back(&I);
-                std::vector<const Function *> nestedCalledFunctions = getCalledFunctions(calledFunction, visited);
+                callSites.push_back(&I);
+                if (!expandCallees) {
+                    continue;
+                }
+                std::vector<const Function *> nestedCalledFunctions = getCalledFunctions(calledFunction, visited, callSites, depth + 1);
                 calledFunctions.insert(calledFunctions.end(), nestedCalledFunctions.begin(), nestedCalledFunctions.end());
             }
         }
@@ -235,70 +272,91 @@ std::vector<const Function *> TaintTracker::getCalledFunctions(const Function *F
 
 
 nlohmann::json TaintTracker::Traceker(const llvm::Function* func, std::vector<std::pair<NodeID, std::string>> paramNodeIDs, std::string funcName) {
-    nlohmann::json result;
-    // 初始化，清空
-    targetedfunctions.clear();
-    targetedinst.clear();
-    std::set<const Function*> visitedFunctions;
-    targetedfunctions = TaintTracker::getCalledFunctions(func,visitedFunctions);
-    // 打印targetedfunctions
+    return SummaryExporter::toJson(traceSummary(func, paramNodeIDs, funcName));
+}
+
+FunctionSummary TaintTracker::traceSummary(const llvm::Function* func, std::vector<std::pair<NodeID, std::string>> paramNodeIDs, std::string funcName) {
+    FunctionSummary result;
+    // 调用链与调用点均为本次分析的局部状态，多个线程可各自独立分析
+    std::vector<const Instruction*> targetedinst;
+    std::vector<const Function*> targetedfunctions;
     TaintMap taintMap(paramNodeIDs, ander);
     std::vector<SummaryItem> summaryItems;
-    
-    SVFUtil::outs() << "Targeted functions:\n";
-    for (const auto& func : targetedfunctions) {
-        SVFUtil::outs() << "  " << func->getName().str() << "\n";
-        for (auto &arg : func->args()) {
-            const Value* argVal = &arg;
-            NodeID nodeId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(argVal);
-            SVFVar* svfVar = pag->getGNode(nodeId);
-            std::cout << "Argument: " << arg.getName().str() << ", NodeID: " << nodeId << std::endl;
-            // 打印nodeid对应的svfvar的值和在llvm中的名称
-            if (svfVar) {
-                std::cout << "SVFVar Value: " << svfVar->toString() << std::endl;
-                std::cout << "LLVM Name: " << svfVar->getValueName() << std::endl;
-            }
+    SliceCache::reset();
+    if (summaryEngine) {
+        // 组合式：只处理导出函数自身的调用点，被调函数的摘要已预先计算，在调用点实例化
+        summaryEngine->processCallSites(func, taintMap, summaryItems, &targetedinst);
+        for (const auto& inst : targetedinst) {
+            targetedfunctions.push_back(SummaryEngine::resolveCallee(SVFUtil::cast<CallBase>(inst)));
         }
-        SVFUtil::outs() << "\n";
+    } else {
+        std::set<const Function*> visitedFunctions;
+        targetedfunctions = TaintTracker::getCalledFunctions(func, visitedFunctions, targetedinst);
     }
-    // 打印targetedinst
-    SVFUtil::outs() << "Targeted instructions:\n";
-    std::set<NodeID> targetidsets;
-    for (const auto& inst : targetedinst) {
-        inst->print(llvm::outs());
-        SVFUtil::outs() << "\n";
-        if (const CallBase* cb = SVFUtil::dyn_cast<CallBase>(inst)) {
-            for (unsigned i = 0; i < cb->arg_size(); ++i) {
-                const Value *operand = cb->getArgOperand(i);
-                NodeID nodeId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(operand);
-                if (targetidsets.count(nodeId) == 0) {
-                    targetidsets.insert(nodeId);
-                }
-                std::cout << "Arg " << i << ": " << operand->getName().str() << ", NodeID: " << nodeId << std::endl;
+    // 打印targetedfunctions
+    
+    if (verbose) {
+        SVFUtil::outs() << "Targeted functions:\n";
+        for (const auto& func : targetedfunctions) {
+            SVFUtil::outs() << "  " << func->getName().str() << "\n";
+            for (auto &arg : func->args()) {
+                const Value* argVal = &arg;
+                NodeID nodeId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(argVal);
                 SVFVar* svfVar = pag->getGNode(nodeId);
+                std::cout << "Argument: " << arg.getName().str() << ", NodeID: " << nodeId << std::endl;
+                // 打印nodeid对应的svfvar的值和在llvm中的名称
                 if (svfVar) {
                     std::cout << "SVFVar Value: " << svfVar->toString() << std::endl;
                     std::cout << "LLVM Name: " << svfVar->getValueName() << std::endl;
                 }
             }
-        } else {
-            for (unsigned i = 0; i < inst->getNumOperands(); ++i) {
-                const Value *operand = inst->getOperand(i);
-                NodeID nodeId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(operand);
-                if (targetidsets.count(nodeId) == 0) {
-                    targetidsets.insert(nodeId);
+            SVFUtil::outs() << "\n";
+        }
+        // 打印targetedinst
+        SVFUtil::outs() << "Targeted instructions:\n";
+    }
+    std::set<NodeID> targetidsets;
+    for (const auto& inst : targetedinst) {
+        // 截止时间已到时不再处理剩余的调用点
+        if (AnalysisBudget::expired()) {
+            break;
+        }
+        if (verbose) {
+            inst->print(TaskOutput::outs());
+            SVFUtil::outs() << "\n";
+            if (const CallBase* cb = SVFUtil::dyn_cast<CallBase>(inst)) {
+                for (unsigned i = 0; i < cb->arg_size(); ++i) {
+                    const Value *operand = cb->getArgOperand(i);
+                    NodeID nodeId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(operand);
+                    if (targetidsets.count(nodeId) == 0) {
+                        targetidsets.insert(nodeId);
+                    }
+                    std::cout << "Arg " << i << ": " << operand->getName().str() << ", NodeID: " << nodeId << std::endl;
+                    SVFVar* svfVar = pag->getGNode(nodeId);
+                    if (svfVar) {
+                        std::cout << "SVFVar Value: " << svfVar->toString() << std::endl;
+                        std::cout << "LLVM Name: " << svfVar->getValueName() << std::endl;
+                    }
                 }
-                std::cout << "Operand " << i << ": " << operand->getName().str() << ", NodeID: " << nodeId << std::endl;
-                SVFVar* svfVar = pag->getGNode(nodeId);
-                if (svfVar) {
-                    std::cout << "SVFVar Value: " << svfVar->toString() << std::endl;
-                    std::cout << "LLVM Name: " << svfVar->getValueName() << std::endl;
+            } else {
+                for (unsigned i = 0; i < inst->getNumOperands(); ++i) {
+                    const Value *operand = inst->getOperand(i);
+                    NodeID nodeId = LLVMModuleSet::getLLVMModuleSet()->getValueNode(operand);
+                    if (targetidsets.count(nodeId) == 0) {
+                        targetidsets.insert(nodeId);
+                    }
+                    std::cout << "Operand " << i << ": " << operand->getName().str() << ", NodeID: " << nodeId << std::endl;
+                    SVFVar* svfVar = pag->getGNode(nodeId);
+                    if (svfVar) {
+                        std::cout << "SVFVar Value: " << svfVar->toString() << std::endl;
+                        std::cout << "LLVM Name: " << svfVar->getValueName() << std::endl;
+                    }
                 }
             }
+            SVFUtil::outs() << "\n";
         }
-        SVFUtil::outs() << "\n";
         // 如果inst是call指令且调用函数名称为napi_get_cb_info，则调用NapiGetCallBackInfo
-        if (llvm::isa<llvm::CallInst>(inst)) {
+        if (!summaryEngine && llvm::isa<llvm::CallInst>(inst)) {
             NapiHandler::getInstance().dispatch(inst, taintMap, svfg, pag, ander, summaryItems);
         }
     }
@@ -362,15 +420,14 @@ nlohmann::json TaintTracker::Traceker(const llvm::Function* func, std::vector<st
         }
     }
     SVFUtil::outs() << "\n";
-    result["name"] = funcName;
-    nlohmann::json paramsJson;
+    result.name = funcName;
     const auto& paramInfos = taintMap.getParamIds();
     for (const auto& paramInfo : paramInfos) {
         std::string key = "%" + std::to_string(paramInfo.paramId);
-        paramsJson[key] = paramInfo.paramName;
+        result.params.emplace_back(key, paramInfo.paramName);
     }
-    result["params"] = paramsJson;
-    result["instructions"] = SummaryExporter::toJson(summaryItems);
+    result.items = summaryItems;
+    result.budget = AnalysisBudget::levelName(AnalysisBudget::resultLevel());
 
     return result;
 }
@@ -380,6 +437,7 @@ nlohmann::json TaintTracker::Traceker(const llvm::Function* func, std::vector<st
 void TaintTracker::aliasAnalysis(SVF::NodeID id) {
     // 获取id的alias
     for (auto node : taintedNodes) {
+        Metrics::countAliasQuery();
         if (ander->alias(id, node) == SVF::AliasResult::MayAlias) {
             if(taintedNodes.count(id) == 0) {
                 taintedNodes.insert(id);
@@ -404,15 +462,15 @@ void TaintTracker::printNodeID(SVF::NodeID nodeId) {
     // 检查是否是虚拟节点
     if (node->getNodeKind() == SVF::SVFValue::DummyValNode || 
         node->getNodeKind() == SVF::SVFValue::DummyObjNode) {
-        llvm::outs() << "NodeID: " << nodeId << " is a dummy node\n";
+        TaskOutput::outs() << "NodeID: " << nodeId << " is a dummy node\n";
         return;
     }
     std::string valName = node->getValueName();
     if (!valName.empty()) {
-        llvm::outs() << "NodeID: " << nodeId << " Value: " << valName << "\n";
+        TaskOutput::outs() << "NodeID: " << nodeId << " Value: " << valName << "\n";
     }
     else {
-        llvm::outs() << "NodeID: " << nodeId << " Value: " << "Unnamed" << "\n";
+        TaskOutput::outs() << "NodeID: " << nodeId << " Value: " << "Unnamed" << "\n";
     }
 }
 
@@ -432,6 +490,7 @@ void TaintTracker::trackValueFlow(SVF::NodeID srcNode) {
     // 获取源节点的VFG节点
     SVF::VFGNode* srcVFGNode = svfg->getVFGNode(srcNode);
     if (!srcVFGNode) return;
+    Metrics::countSvfgNodeVisit();
 
     // 打印getNodekind
     SVFUtil::outs() << "Node kind: " << srcVFGNode->getNodeKind() << "\n";